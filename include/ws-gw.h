@@ -1,19 +1,36 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <deque>
 #include <exception>
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#ifdef WSGW_COROUTINE
+#include <coroutine>
+#endif
 
 #include <flatbuffers/flatbuffers.h>
+#include <flatbuffers/flexbuffers.h>
 #include <websocketpp/client.hpp>
 #include <websocketpp/common/system_error.hpp>
 #include <websocketpp/config/asio_no_tls_client.hpp>
@@ -22,6 +39,7 @@ namespace WsGw {
 
 class Service;
 class Buffer;
+class SharedBuffer;
 
 class BufferView {
   friend class Service;
@@ -32,12 +50,14 @@ class BufferView {
 public:
   BufferView() {}
   BufferView(Buffer const &buffer);
+  BufferView(SharedBuffer const &buffer);
   BufferView(uint8_t const *data, size_t len) : storage(data, len) {}
   BufferView(std::string const &data) : storage((uint8_t const *) data.data(), data.size()) {}
   BufferView(std::string_view data) : storage((uint8_t const *) data.data(), data.size()) {}
   BufferView(std::basic_string<uint8_t> const &data) : storage(data) {}
   BufferView(std::basic_string_view<uint8_t> const &data) : storage(data) {}
   BufferView(flatbuffers::FlatBufferBuilder const &builder) : storage(builder.GetBufferPointer(), builder.GetSize()) {}
+  BufferView(flexbuffers::Builder const &builder) : storage(builder.GetBuffer().data(), builder.GetBuffer().size()) {}
 
   uint8_t const *data() const noexcept { return storage.data(); }
   size_t size() const noexcept { return storage.size(); }
@@ -47,81 +67,391 @@ public:
   operator std::string_view() const noexcept { return {(char const *) storage.data(), storage.size()}; }
 };
 
-class Buffer;
+// Owns a payload. Up to inlineCapacity bytes are stored inside the object itself; larger payloads keep the container
+// or finished builder they were moved in from, or adopt foreign memory released through a deleter. Moving a Buffer
+// moves inline payloads (and short std::strings) byte by byte, so views taken before the move dangle afterwards.
+class Buffer {
+public:
+  static constexpr size_t inlineCapacity = 64;
+
+private:
+  struct Small {
+    uint8_t size;
+    uint8_t bytes[inlineCapacity];
+  };
+  struct Adopted {
+    uint8_t const *data;
+    size_t size;
+    std::function<void(uint8_t const *, size_t)> deleter;
+
+    Adopted(uint8_t const *data, size_t size, std::function<void(uint8_t const *, size_t)> deleter)
+        : data(data), size(size), deleter(std::move(deleter)) {}
+    Adopted(Adopted &&rhs) noexcept
+        : data(std::exchange(rhs.data, nullptr)), size(rhs.size), deleter(std::move(rhs.deleter)) {}
+    Adopted &operator=(Adopted &&rhs) noexcept {
+      std::swap(data, rhs.data);
+      std::swap(size, rhs.size);
+      std::swap(deleter, rhs.deleter);
+      return *this;
+    }
+    ~Adopted() {
+      if (data && deleter) deleter(data, size);
+    }
+  };
+  std::variant<
+      std::monostate,
+      Small,
+      std::string,
+      std::basic_string<uint8_t>,
+      std::vector<uint8_t>,
+      flatbuffers::DetachedBuffer,
+      Adopted,
+      std::shared_ptr<Buffer const>>
+      storage;
+
+  template <typename T> void Assign(T const *data, size_t len) {
+    if (len <= inlineCapacity) {
+      auto &small = storage.emplace<Small>();
+      small.size  = (uint8_t) len;
+      std::memcpy(small.bytes, data, len);
+    } else {
+      storage.emplace<std::basic_string<T>>(data, len);
+    }
+  }
 
-class BufferImpl {
-  friend class Buffer;
+  using Bytes = std::basic_string_view<uint8_t>;
+  static Bytes View(std::monostate) noexcept { return {}; }
+  static Bytes View(Small const &small) noexcept { return {small.bytes, small.size}; }
+  static Bytes View(std::string const &str) noexcept { return {(uint8_t const *) str.data(), str.size()}; }
+  static Bytes View(std::basic_string<uint8_t> const &str) noexcept { return str; }
+  static Bytes View(std::vector<uint8_t> const &vec) noexcept { return {vec.data(), vec.size()}; }
+  static Bytes View(flatbuffers::DetachedBuffer const &detached) noexcept { return {detached.data(), detached.size()}; }
+  static Bytes View(Adopted const &adopted) noexcept { return {adopted.data, adopted.size}; }
+  static Bytes View(std::shared_ptr<Buffer const> const &shared) noexcept { return shared->View(); }
+  Bytes View() const noexcept {
+    if (storage.valueless_by_exception()) return {};
+    return std::visit([](auto const &member) { return View(member); }, storage);
+  }
 
 public:
-  virtual ~BufferImpl() {}
-  virtual uint8_t const *data() const noexcept = 0;
-  virtual size_t size() const noexcept         = 0;
+  Buffer() {}
+  Buffer(char const *str) { Assign(str, std::strlen(str)); }
+  Buffer(std::string str) : storage(std::move(str)) {}
+  Buffer(char const *data, size_t len) { Assign(data, len); }
+  Buffer(std::basic_string<uint8_t> str) : storage(std::move(str)) {}
+  Buffer(uint8_t const *data, size_t len) { Assign(data, len); }
+  Buffer(flatbuffers::FlatBufferBuilder &&builder) : storage(builder.Release()) {}
+  Buffer(std::vector<uint8_t> &&vec) : storage(std::move(vec)) {}
+  Buffer(flatbuffers::DetachedBuffer &&detached) : storage(std::move(detached)) {}
+  Buffer(std::unique_ptr<uint8_t[]> data, size_t len)
+      : storage(std::in_place_type<Adopted>, data.release(), len, [](uint8_t const *data, size_t) { delete[] data; }) {}
+  // Takes ownership of data; deleter is called with data and len once the Buffer is destroyed.
+  Buffer(uint8_t const *data, size_t len, std::function<void(uint8_t const *, size_t)> deleter)
+      : storage(std::in_place_type<Adopted>, data, len, std::move(deleter)) {}
+
+  // Shares the payload instead of copying it.
+  Buffer(SharedBuffer shared);
+
+  // Maps the whole file read-only; throws std::system_error when it cannot be opened or mapped.
+  static Buffer MapFile(std::string const &path);
+
+  uint8_t const *data() const noexcept { return View().data(); }
+  size_t size() const noexcept { return View().size(); }
+
+  operator std::string() const noexcept { return {(char const *) data(), size()}; }
+  operator std::basic_string<uint8_t>() const noexcept { return {data(), size()}; }
+  operator std::basic_string_view<uint8_t>() const noexcept { return {data(), size()}; }
+  operator std::string_view() const noexcept { return {(char const *) data(), size()}; }
+
+  std::string str() { return *this; }
 };
 
-class BufferImplString : public BufferImpl {
-  std::string storage;
+// Immutable, atomically reference-counted Buffer; copies share ownership of one payload. It only saves copying the
+// payload between owners: each send still encodes its own frame around it.
+class SharedBuffer {
   friend class Buffer;
+  std::shared_ptr<Buffer const> ptr;
 
 public:
-  BufferImplString(std::string data) : storage(std::move(data)) {}
-  BufferImplString(char const *data, size_t len) : storage(data, len) {}
+  SharedBuffer() {}
+  SharedBuffer(Buffer buffer) : ptr(std::make_shared<Buffer const>(std::move(buffer))) {}
 
-  uint8_t const *data() const noexcept { return (uint8_t const *) storage.data(); }
+  uint8_t const *data() const noexcept { return ptr ? ptr->data() : nullptr; }
+  size_t size() const noexcept { return ptr ? ptr->size() : 0; }
 
-  size_t size() const noexcept { return storage.size(); }
+  operator std::string() const noexcept { return {(char const *) data(), size()}; }
+  operator std::basic_string<uint8_t>() const noexcept { return {data(), size()}; }
+  operator std::basic_string_view<uint8_t>() const noexcept { return {data(), size()}; }
+  operator std::string_view() const noexcept { return {(char const *) data(), size()}; }
 };
 
-class BufferImplUString : public BufferImpl {
-  std::basic_string<uint8_t> storage;
-  friend class Buffer;
+inline Buffer::Buffer(SharedBuffer shared) {
+  if (shared.ptr) storage = std::move(shared.ptr);
+}
+
+inline BufferView::BufferView(Buffer const &buf) : storage(buf.data(), buf.size()) {}
+inline BufferView::BufferView(SharedBuffer const &buf) : storage(buf.data(), buf.size()) {}
+
+struct Error {
+  std::string message;
+
+  explicit Error(std::string message) : message(std::move(message)) {}
+};
+
+// Either a value or an Error; returned by handlers that want to fail without throwing.
+template <typename T> class Expected {
+  std::variant<T, Error> storage;
 
 public:
-  BufferImplUString(std::basic_string<uint8_t> data) : storage(std::move(data)) {}
-  BufferImplUString(uint8_t const *data, size_t len) : storage(data, len) {}
+  Expected(T value) : storage(std::in_place_index<0>, std::move(value)) {}
+  Expected(Error error) : storage(std::in_place_index<1>, std::move(error)) {}
 
-  uint8_t const *data() const noexcept { return (uint8_t const *) storage.data(); }
+  bool has_value() const noexcept { return storage.index() == 0; }
+  explicit operator bool() const noexcept { return has_value(); }
 
-  size_t size() const noexcept { return storage.size(); }
+  T &value() { return std::get<0>(storage); }
+  T const &value() const { return std::get<0>(storage); }
+  Error &error() { return std::get<1>(storage); }
+  Error const &error() const { return std::get<1>(storage); }
 };
 
-class BufferImplBuilder : public BufferImpl {
-  flatbuffers::FlatBufferBuilder storage;
-  friend class Buffer;
+// The request Buffer may hold its bytes inline; keep the Buffer itself alive (move it into the continuation) rather
+// than views into it, since moving it relocates those bytes.
+using Handler         = std::function<void(Buffer, std::function<void(std::exception_ptr ep, BufferView)>)>;
+using SyncHandler     = std::function<Buffer(BufferView const &)>;
+using ExpectedHandler = std::function<Expected<Buffer>(BufferView const &)>;
+using DirectHandler   = Expected<Buffer> (*)(BufferView const &);
+// The handler reads the request through a Reference into the inbound frame and writes exactly one value, the
+// response, into a pooled builder; see Service::RegisterFlexHandler. Requests come from arbitrary clients through
+// the gateway: with flatbuffers 2.0 or later the payload is verified before the handler runs, but older versions
+// cannot verify FlexBuffers and the handler must then bounds-check every access itself.
+using FlexHandler = std::function<void(flexbuffers::Reference, flexbuffers::Builder &)>;
+
+// Reference to the root of a FlexBuffer payload; nothing is copied. The payload is not verified: check untrusted
+// input with flexbuffers::VerifyBuffer (flatbuffers 2.0 and later) first, or bounds-check every access.
+inline flexbuffers::Reference FlexRoot(BufferView const &view) { return flexbuffers::GetRoot(view.data(), view.size()); }
+
+// Reusable FlexBuffer builders. A Handle returns its builder to the pool, cleared, when it goes out of scope.
+class FlexBuilderPool {
+  std::mutex mtx;
+  std::vector<std::unique_ptr<flexbuffers::Builder>> free;
 
 public:
-  BufferImplBuilder(flatbuffers::FlatBufferBuilder &&orig) : storage(std::move(orig)) {}
+  struct Deleter {
+    FlexBuilderPool *pool;
+    void operator()(flexbuffers::Builder *builder) const { pool->Release(builder); }
+  };
+  using Handle = std::unique_ptr<flexbuffers::Builder, Deleter>;
+
+  Handle Acquire();
+  void Release(flexbuffers::Builder *builder) noexcept;
+};
 
-  uint8_t const *data() const noexcept { return storage.GetBufferPointer(); }
+// Builds the response table into the builder and returns its offset; see Service::RegisterHandler<Req, Resp>.
+using TypedHandler = std::function<Expected<flatbuffers::uoffset_t>(BufferView const &, flatbuffers::FlatBufferBuilder &)>;
 
-  size_t size() const noexcept { return storage.GetSize(); }
+struct StaticHandler {
+  std::string_view key;
+  DirectHandler handler;
 };
 
-class Buffer {
-  std::unique_ptr<BufferImpl> impl;
+namespace detail {
+constexpr uint32_t StaticHash(std::string_view key, uint32_t seed) {
+  uint32_t hash = 2166136261u ^ seed;
+  for (auto c : key) hash = (hash ^ (uint8_t) c) * 16777619u;
+  return hash;
+}
+} // namespace detail
+
+// Perfect hash over a constexpr array of StaticHandlers, built at compile time by hash-and-displace: keys are split
+// into buckets by one hash, and each bucket, largest first, gets the seed of a second hash that sends all of its keys
+// to free slots. Table must have static storage duration and unique keys.
+template <auto const &Table> class StaticTable {
+  static constexpr size_t count   = std::size(Table);
+  static constexpr size_t buckets = (count + 1) / 2;
+  static constexpr size_t slots   = [] {
+    size_t n = 1;
+    while (n < count * 2) n <<= 1;
+    return n;
+  }();
+
+  struct Layout {
+    bool duplicate, found;
+    std::array<uint32_t, buckets> seeds;
+    std::array<int, slots> index;
+  };
+
+  static constexpr size_t Bucket(std::string_view key) { return detail::StaticHash(key, 0) % buckets; }
+  static constexpr size_t Slot(std::string_view key, uint32_t seed) { return detail::StaticHash(key, seed) & (slots - 1); }
+
+  static constexpr Layout layout = [] {
+    Layout result{};
+    for (auto &slot : result.index) slot = -1;
+    // Keys grouped by bucket: members[start[b]] up to members[start[b + 1]].
+    std::array<size_t, buckets + 1> start{};
+    std::array<size_t, count> members{};
+    for (size_t i = 0; i < count; i++) start[Bucket(Table[i].key) + 1]++;
+    for (size_t b = 0; b < buckets; b++) start[b + 1] += start[b];
+    auto next = start;
+    for (size_t i = 0; i < count; i++) members[next[Bucket(Table[i].key)]++] = i;
+    size_t largest = 0;
+    for (size_t b = 0; b < buckets; b++) {
+      largest = std::max(largest, start[b + 1] - start[b]);
+      for (size_t i = start[b]; i < start[b + 1]; i++)
+        for (size_t j = start[b]; j < i; j++)
+          if (Table[members[i]].key == Table[members[j]].key) result.duplicate = true;
+    }
+    result.found = !result.duplicate;
+    for (size_t want = largest; want > 0 && result.found; want--) {
+      for (size_t b = 0; b < buckets && result.found; b++) {
+        if (start[b + 1] - start[b] != want) continue;
+        uint32_t seed = 0;
+        result.found  = false;
+        while (!result.found && ++seed < (1u << 16)) {
+          result.found = true;
+          for (size_t i = start[b]; i < start[b + 1] && result.found; i++) {
+            auto slot = Slot(Table[members[i]].key, seed);
+            if (result.index[slot] >= 0) result.found = false;
+            for (size_t j = start[b]; j < i; j++)
+              if (Slot(Table[members[j]].key, seed) == slot) result.found = false;
+          }
+        }
+        result.seeds[b] = seed;
+        for (size_t i = start[b]; i < start[b + 1] && result.found; i++)
+          result.index[Slot(Table[members[i]].key, seed)] = (int) members[i];
+      }
+    }
+    return result;
+  }();
+  static_assert(!layout.duplicate, "static handler keys must be unique");
+  static_assert(layout.duplicate || layout.found, "no perfect hash found for the static handler keys");
 
 public:
-  Buffer() : impl() {}
-  Buffer(std::string str) : impl(std::make_unique<BufferImplString>(str)) {}
-  Buffer(char const *data, size_t len) : impl(std::make_unique<BufferImplString>(data, len)) {}
-  Buffer(std::basic_string<uint8_t> str) : impl(std::make_unique<BufferImplUString>(str)) {}
-  Buffer(uint8_t const *data, size_t len) : impl(std::make_unique<BufferImplUString>(data, len)) {}
-  Buffer(flatbuffers::FlatBufferBuilder &&builder) : impl(std::make_unique<BufferImplBuilder>(std::move(builder))) {}
+  static constexpr int Find(std::string_view key) {
+    int index = layout.index[Slot(key, layout.seeds[Bucket(key)])];
+    return index >= 0 && Table[index].key == key ? index : -1;
+  }
+};
 
-  uint8_t const *data() const noexcept { return impl ? impl->data() : nullptr; }
-  size_t size() const noexcept { return impl ? impl->size() : 0; }
+#ifdef WSGW_COROUTINE
+// Size-bucketed free lists for coroutine frames, shared by every handler of one Service.
+class FramePool {
+  static constexpr size_t granularity = 64;
+  std::mutex mtx;
+  std::array<void *, 16> freelist{};
 
-  operator std::string() const noexcept { return {(char const *) data(), size()}; }
-  operator std::basic_string<uint8_t>() const noexcept { return {data(), size()}; }
-  operator std::basic_string_view<uint8_t>() const noexcept { return {data(), size()}; }
-  operator std::string_view() const noexcept { return {(char const *) data(), size()}; }
+public:
+  FramePool() {}
+  FramePool(FramePool const &) = delete;
+  ~FramePool();
 
-  std::string str() { return *this; }
+  void *Allocate(size_t size);
+  void Deallocate(void *ptr, size_t size) noexcept;
 };
 
-inline BufferView::BufferView(Buffer const &buf) : storage(buf.data(), buf.size()) {}
+namespace detail {
+
+inline thread_local FramePool *currentFramePool = nullptr;
+
+struct FramePoolScope {
+  FramePool *saved;
+  FramePoolScope(FramePool &pool) : saved(currentFramePool) { currentFramePool = &pool; }
+  ~FramePoolScope() { currentFramePool = saved; }
+};
+
+// Frames created while a FramePoolScope is active come from that pool; the owning pool is stored in front of the
+// frame so it can be returned from whichever thread finishes the coroutine.
+struct FramePromise {
+  static constexpr size_t header = alignof(std::max_align_t);
+
+  static void *operator new(size_t size) {
+    auto pool = currentFramePool;
+    auto raw  = pool ? pool->Allocate(size + header) : ::operator new(size + header);
+    *static_cast<FramePool **>(raw) = pool;
+    return static_cast<std::byte *>(raw) + header;
+  }
+  static void operator delete(void *ptr, size_t size) noexcept {
+    auto raw  = static_cast<std::byte *>(ptr) - header;
+    auto pool = *reinterpret_cast<FramePool **>(raw);
+    if (pool)
+      pool->Deallocate(raw, size + header);
+    else
+      ::operator delete(raw);
+  }
+};
+
+struct TaskPromiseBase : FramePromise {
+  std::coroutine_handle<> continuation;
+  std::exception_ptr ep;
+
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+    template <typename P> std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+      auto cont = h.promise().continuation;
+      return cont ? cont : std::noop_coroutine();
+    }
+    void await_resume() const noexcept {}
+  };
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  FinalAwaiter final_suspend() const noexcept { return {}; }
+  void unhandled_exception() noexcept { ep = std::current_exception(); }
+};
+
+template <typename T> struct TaskPromise : TaskPromiseBase {
+  std::optional<T> value;
+
+  void return_value(T result) { value.emplace(std::move(result)); }
+  T take() {
+    if (ep) std::rethrow_exception(ep);
+    return std::move(*value);
+  }
+};
+
+template <> struct TaskPromise<void> : TaskPromiseBase {
+  void return_void() noexcept {}
+  void take() {
+    if (ep) std::rethrow_exception(ep);
+  }
+};
+
+} // namespace detail
+
+// Lazily started coroutine result; awaiting it starts the body and resumes the awaiter when it finishes.
+template <typename T> class Task {
+public:
+  struct promise_type : detail::TaskPromise<T> {
+    Task get_return_object() noexcept { return Task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+  };
+
+private:
+  std::coroutine_handle<promise_type> handle;
+
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+public:
+  Task(Task &&rhs) noexcept : handle(std::exchange(rhs.handle, nullptr)) {}
+  Task &operator=(Task &&rhs) noexcept {
+    if (this != &rhs) {
+      if (handle) handle.destroy();
+      handle = std::exchange(rhs.handle, nullptr);
+    }
+    return *this;
+  }
+  ~Task() {
+    if (handle) handle.destroy();
+  }
+
+  bool await_ready() const noexcept { return false; }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> cont) noexcept {
+    handle.promise().continuation = cont;
+    return handle;
+  }
+  T await_resume() { return handle.promise().take(); }
+};
 
-using Handler     = std::function<void(Buffer, std::function<void(std::exception_ptr ep, BufferView)>)>;
-using SyncHandler = std::function<Buffer(BufferView const &)>;
+using CoHandler = std::function<Task<Buffer>(Buffer)>;
+#endif
 
 struct MagicError : std::runtime_error {
   MagicError(char const *expected, char const *actual)
@@ -130,6 +460,12 @@ struct MagicError : std::runtime_error {
 struct ConnectFailedError : std::runtime_error {
   ConnectFailedError() : runtime_error("Failed to connect") {}
 };
+struct ConnectTimeoutError : std::runtime_error {
+  ConnectTimeoutError() : runtime_error("Connect timed out") {}
+};
+struct HeartbeatTimeoutError : std::runtime_error {
+  HeartbeatTimeoutError() : runtime_error("Heartbeat timed out") {}
+};
 struct DisconnectedError : std::runtime_error {
   DisconnectedError() : runtime_error("Disconnected") {}
 };
@@ -151,39 +487,462 @@ struct ServiceDesc {
   std::string name, identifier, version;
 };
 
+enum class TraceStage : uint8_t { Verify, Handler, Encode, Send };
+
+// Receives the lifecycle of each request: Verify spans frame read to verification, Handler spans dispatch to the
+// handler's callback, Encode covers building the reply and Send covers handing it to the socket.
+class Tracer {
+public:
+  using clock = std::chrono::steady_clock;
+
+  virtual ~Tracer() {}
+  virtual void Start(uint32_t /*id*/, TraceStage /*stage*/, clock::time_point /*ts*/) {}
+  virtual void Stop(uint32_t /*id*/, TraceStage /*stage*/, clock::time_point /*ts*/) {}
+};
+
+enum class BroadcastStatus : uint8_t { Sent, Conflated, Offline, Backpressured, NoSubscribers };
+
+// Outbound congestion handling, driven by the connection's buffered amount. Congestion starts when it exceeds
+// highWatermark (zero disables) and ends once it has fallen to lowWatermark.
+struct BackpressureOptions {
+  size_t highWatermark = 0, lowWatermark = 0;
+  bool pauseRequests   = true;  // stop reading from the socket until the queue drains
+  size_t maxPaused     = 1024;  // frames already read when reading stopped that are held; later requests are shed
+  bool failBroadcasts  = false; // Broadcast returns BroadcastStatus::Backpressured
+  bool dropConflated   = false; // conflated keys keep only their latest value until the queue drains
+  std::chrono::milliseconds pollInterval{1};
+  std::function<void()> onHighWatermark, onLowWatermark;
+};
+
+// Per-key admission limits; zero means unlimited. The token bucket holds up to burst tokens (at least one) and
+// refills at rate tokens per second.
+struct HandlerLimits {
+  uint32_t maxConcurrent = 0;
+  double rate = 0, burst = 0;
+};
+
+// Response memoization for SyncHandlers whose result depends only on the payload. Entries expire after ttl (zero
+// keeps them until evicted) and the least recently used ones are evicted once the cache holds more than maxBytes.
+struct CacheOptions {
+  std::chrono::milliseconds ttl{0};
+  size_t maxBytes = 1 << 20;
+};
+
+// Liveness probing with WebSocket pings, sent once per interval (zero disables) while connected. A ping left
+// unanswered for timeout drops the connection. With reconnect set, a connection that is dropped or closed after the
+// first handshake is re-established, waiting reconnectDelay and doubling that on each further attempt up to
+// maxReconnectDelay; an attempt whose handshake is not answered within timeout is dropped and retried the same way.
+// Otherwise the Service stops.
+struct HeartbeatOptions {
+  std::chrono::milliseconds interval{0}, timeout{10000};
+  bool reconnect = false;
+  std::chrono::milliseconds reconnectDelay{100}, maxReconnectDelay{10000};
+};
+
+struct ServiceStats {
+  uint64_t framesIn = 0, framesOut = 0, bytesIn = 0, bytesOut = 0, verifyFailures = 0, reconnects = 0;
+  int64_t inflight  = 0;
+  size_t sendQueue  = 0;
+  std::map<std::string, uint64_t> broadcasts; // keys of hosted services are prefixed with "name/"
+  std::chrono::microseconds rtt{0}, rttJitter{0}; // smoothed heartbeat round trip and its mean deviation
+};
+
+class BroadcastChannel;
+class HostedService;
+class StreamWriter;
+class StreamReader;
+
+// Receives the request payload and a writer for the response stream.
+using StreamHandler = std::function<void(Buffer, std::shared_ptr<StreamWriter>)>;
+// Receives a reader for the request payload and completes like a Handler.
+using UploadHandler =
+    std::function<void(std::shared_ptr<StreamReader>, std::function<void(std::exception_ptr ep, BufferView)>)>;
+
 class Service {
+  friend class BroadcastChannel;
+  friend class HostedService;
+  friend class StreamWriter;
+  friend class StreamReader;
   using client = websocketpp::client<websocketpp::config::asio_client>;
+
+#ifdef WSGW_COROUTINE
+  FramePool pool;
+#endif
+
+  struct alignas(64) StatsSlot {
+    std::atomic_uint64_t framesIn{}, framesOut{}, bytesIn{}, bytesOut{}, verifyFailures{};
+    std::atomic_int64_t inflight{};
+  };
+  struct KeyState;
+
   client ws;
+  struct Gate;
+  struct Cache;
+  struct Flights;
+  struct HandlerEntry {
+    Handler async;
+    ExpectedHandler sync;
+    DirectHandler direct = nullptr;
+    TypedHandler typed;
+    StreamHandler stream;
+    UploadHandler upload;
+    std::shared_ptr<Gate> gate;
+    std::shared_ptr<Cache> cache;
+    std::shared_ptr<Flights> flights;
+
+    bool Empty() const { return !async && !sync && !direct && !typed && !stream && !upload; }
+    bool Inline() const { return sync || direct || typed; }
+  };
+
+  using HandlerTable = std::map<std::string, HandlerEntry, std::less<>>;
+  struct Hosted {
+    ServiceDesc desc;
+    HandlerTable mapped;
+  };
+  // Broadcast keys are ordered by service index, then name; lookups take a std::pair<uint32_t, std::string_view>.
+  struct KeyOrder {
+    using is_transparent = void;
+    template <typename A, typename B> bool operator()(A const &a, B const &b) const {
+      return std::pair<uint32_t, std::string_view>{a} < std::pair<uint32_t, std::string_view>{b};
+    }
+  };
+
   Handler defaultHandler;
-  std::map<std::string, Handler> mapped;
+  HandlerTable mapped;
+  std::deque<Hosted> hosted;                          // multiplexed services, hosted[i] having service index i + 1
+  std::vector<std::vector<HandlerEntry *>> announced; // per service index, in handshake order
+  std::vector<HandlerEntry *> methods;                // indexed by method id
+  FlexBuilderPool flexPool;
+  std::mutex streammtx;
+  std::map<uint32_t, std::weak_ptr<StreamWriter>> streams;
+  std::atomic_uint32_t streamWindow = 0;
+  std::map<uint32_t, std::shared_ptr<StreamReader>> uploads;
+  std::vector<HandlerEntry *> fixed;              // indexed by the static table's perfect hash
+  int (*fixedFind)(std::string_view) = nullptr;
   std::atomic_int8_t flag = 0;
   std::mutex mtx;
   std::condition_variable cv;
   std::exception_ptr ep;
+  std::shared_mutex conmtx; // conhdr and generation change on the io thread only; other threads read them under it
   websocketpp::connection_hdl conhdr;
-  std::function<void(std::exception_ptr)> onstop;
+  uint32_t generation = 0; // bumped whenever a connection is dropped
+  std::function<void(std::exception_ptr)> onstop, onconnect;
+  client::timer_ptr connectTimer;
+  std::string endpoint;
+  HeartbeatOptions heartbeat;
+  client::timer_ptr heartbeatTimer;
+  Tracer::clock::time_point pinged;
+  bool awaitingPong = false;
+  uint32_t pingSeq  = 0;
+  std::chrono::milliseconds backoff{0};
+  std::atomic_int64_t srtt = 0, rttvar = 0; // microseconds
+  std::shared_ptr<Tracer> tracer;
+  std::array<StatsSlot, 16> slots;
+  std::atomic_uint64_t reconnects = 0;
+  bool established                = false;
+  std::atomic_uint32_t features   = 0;
+  std::shared_mutex keymtx;
+  std::map<std::pair<uint32_t, std::string>, std::shared_ptr<KeyState>, KeyOrder> keys;
+  uint32_t lastKeyId = 0;
+  BackpressureOptions backpressure;
+  std::atomic_bool congested = false;
+  std::deque<websocketpp::config::asio_client::message_type::ptr> paused;
+  uint32_t maxInflight = 0;
+  std::atomic_uint32_t running = 0;
 
   void OnMessage(websocketpp::connection_hdl hdl, websocketpp::config::asio_client::message_type::ptr msg);
+  HandlerTable &Table(uint32_t service) { return service ? hosted[service - 1].mapped : mapped; }
+  void Register(std::string const &name, Handler async, ExpectedHandler sync, uint32_t service = 0);
+  void RegisterTyped(std::string const &name, TypedHandler handler);
+  void Send(uint8_t const *data, size_t size, std::optional<uint32_t> gen = {});
+  websocketpp::connection_hdl Connection();
+  std::string const *Admit(Gate *gate);
+  void Release(Gate *gate);
+  void Complete(uint32_t id);
+  void Transmit(uint32_t id, BufferView packet, uint32_t gen);
+  void SendResponse(uint32_t id, BufferView view, uint32_t gen);
+  void SendException(uint32_t id, std::string_view message, uint32_t gen);
+  void SendChunk(uint32_t id, uint32_t seq, BufferView chunk, bool last, uint32_t gen);
+  std::shared_ptr<StreamWriter> Stream(uint32_t id);
+  std::shared_ptr<StreamReader> Upload(uint32_t id, bool erase);
+  StatsSlot &Slot();
+  KeyState &Key(std::string_view key, uint32_t service = 0);
+  BroadcastStatus Broadcast(KeyState &state, BufferView data);
+  bool Bind(KeyState &state);
+  void Publish(KeyState &state, BufferView data);
+  BroadcastStatus Conflate(KeyState &state, BufferView data);
+  void Flush(KeyState &state);
+  size_t SendQueue();
+  void Congest();
+  void Drain();
+  void SetReading(bool on);
+  bool HasSubscribers(std::string_view key, uint32_t service);
+  void Heartbeat();
+  void OnPong(std::string const &payload);
+  void Drop();
+  void Reconnect();
 
 public:
   Service(Handler defaultHandler) : defaultHandler(defaultHandler) {}
 
-  void RegisterHandler(std::string const &name, Handler handler) { mapped.emplace(name, handler); }
+  void RegisterHandler(std::string const &name, Handler handler) { Register(name, std::move(handler), {}); }
   void RegisterHandler(std::string const &name, SyncHandler handler) {
-    mapped.emplace(name, [=](auto buffer, auto cb) {
-      try {
-        cb(nullptr, handler(buffer));
-      } catch (std::exception const &ex) { cb(std::make_exception_ptr(ex), {}); }
-    });
+    Register(name, {}, [=](BufferView const &view) -> Expected<Buffer> { return handler(view); });
+  }
+  template <
+      typename F,
+      std::enable_if_t<std::is_same_v<std::invoke_result_t<F &, BufferView const &>, Expected<Buffer>>, int> = 0>
+  void RegisterHandler(std::string const &name, F handler) {
+    Register(name, {}, std::move(handler));
   }
 
-  void OnStop(std::function<void(std::exception_ptr)> fn) { onstop = fn; }
+  // The response is finished by the Service and copied once, from the pooled builder, into the outgoing SendPacket.
+  void RegisterFlexHandler(std::string const &name, FlexHandler handler);
+  // For building broadcast or response payloads outside a FlexHandler; pass the finished builder as a BufferView.
+  FlexBuilderPool::Handle FlexBuilder() { return flexPool.Acquire(); }
+
+  // The handler may keep the writer and produce the stream from any thread.
+  void RegisterStreamHandler(std::string const &name, StreamHandler handler);
+
+  // Streamed requests are handed over as soon as their first part arrives.
+  void RegisterUploadHandler(std::string const &name, UploadHandler handler);
+
+  // The payload is verified as a Req flatbuffer and the handler gets a pointer into the inbound frame. It builds its
+  // Resp table into the outgoing builder, which must be empty when it is passed in, and returns the table's offset:
+  //   flatbuffers::Offset<Resp> handler(Req const *req, flatbuffers::FlatBufferBuilder &buf);
+  // The response is sent as a nested flatbuffer without being copied. Responses are not cached.
+  template <typename Req, typename Resp, typename F> void RegisterHandler(std::string const &name, F handler) {
+    RegisterTyped(
+        name,
+        [handler{std::move(handler)}](
+            BufferView const &view, flatbuffers::FlatBufferBuilder &buf) -> Expected<flatbuffers::uoffset_t> {
+          flatbuffers::Verifier verifier{view.data(), view.size()};
+          if (!verifier.VerifyBuffer<Req>(nullptr)) return Error{"Invalid request payload"};
+          flatbuffers::Offset<Resp> resp = handler(flatbuffers::GetRoot<Req>(view.data()), buf);
+          return resp.o;
+        });
+  }
+
+  // Registers a fixed key set, for example
+  //   static constexpr WsGw::StaticHandler table[] = {{"tip", [](auto &) -> WsGw::Expected<WsGw::Buffer> { ... }}};
+  //   srv.RegisterStatic<table>();
+  // Request keys are resolved through a compile-time perfect hash and the handlers are called through plain function
+  // pointers. Limits, caching and method ids apply as for other keys.
+  template <auto const &Table> void RegisterStatic() {
+    fixed.clear();
+    for (auto &item : Table) {
+      auto &entry = mapped[std::string{item.key}];
+      if (entry.Empty()) entry.direct = item.handler;
+      fixed.push_back(&entry);
+    }
+    fixedFind = &StaticTable<Table>::Find;
+  }
 
-  void Broadcast(std::string_view const &key, BufferView data);
+#ifdef WSGW_COROUTINE
+  void RegisterHandler(std::string const &name, CoHandler handler);
+
+  // Resumes the awaiting coroutine on the Service's executor.
+  auto Schedule() {
+    struct Awaiter {
+      Service *srv;
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(std::coroutine_handle<> h) {
+        srv->Post([h] { h.resume(); });
+      }
+      void await_resume() const noexcept {}
+    };
+    return Awaiter{this};
+  }
 
-  void Connect(std::string const &endpoint, ServiceDesc desc);
+  // Adapts a callback-style operation: start receives a completion callback taking (std::exception_ptr, T), and the
+  // awaiting coroutine is resumed on the Service's executor once it is called.
+  template <typename T, typename F> auto Await(F start) {
+    struct Awaiter {
+      Service *srv;
+      F start;
+      std::optional<T> value;
+      std::exception_ptr ep;
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(std::coroutine_handle<> h) {
+        start([this, h](std::exception_ptr ep, T value) {
+          if (ep)
+            this->ep = ep;
+          else
+            this->value.emplace(std::move(value));
+          srv->Post([h] { h.resume(); });
+        });
+      }
+      T await_resume() {
+        if (ep) std::rethrow_exception(ep);
+        return std::move(*value);
+      }
+    };
+    return Awaiter{this, std::move(start)};
+  }
+#endif
+
+  void Post(std::function<void()> fn);
+
+  void OnStop(std::function<void(std::exception_ptr)> fn) { onstop = fn; }
+  void SetTracer(std::shared_ptr<Tracer> value) { tracer = std::move(value); }
+  // Call before connecting.
+  void SetHeartbeat(HeartbeatOptions options) { heartbeat = options; }
+
+  ServiceStats Stats();
+  void EnableStatsHandler(std::string const &name = "$stats");
+
+  BroadcastStatus Broadcast(std::string_view const &key, BufferView data);
+  // Sends every update in one frame. Keys without subscribers are skipped and conflated keys are conflated as usual;
+  // only Offline and Backpressured are reported for the batch as a whole.
+  BroadcastStatus Broadcast(std::vector<std::pair<std::string_view, BufferView>> const &items);
+  // Resolves key once; publishing through the handle skips the lookup and reuses the serialized key.
+  BroadcastChannel Channel(std::string_view key);
+  // True unless the gateway reported that nobody is subscribed to key; lets producers skip building the payload.
+  bool HasSubscribers(std::string_view key);
+  // Only the latest value of a conflated key is kept; it is published at most once per interval (zero disables).
+  void SetConflation(std::string_view key, std::chrono::microseconds interval);
+  void SetBackpressure(BackpressureOptions options);
+  // Requests over a limit are answered at once with an exception instead of being queued.
+  void SetLimits(std::string const &name, HandlerLimits limits);
+  void SetGlobalLimit(uint32_t maxInflight) { this->maxInflight = maxInflight; }
+  // Only applies to SyncHandlers; failed results are never cached.
+  void EnableCache(std::string const &name, CacheOptions options = {});
+  void InvalidateCache(std::string const &name);
+  void InvalidateCache(std::string const &name, BufferView payload);
+  // Requests whose payload matches one already running on an async handler wait for its result instead of calling
+  // the handler again.
+  void EnableCoalescing(std::string const &name);
+
+  // Adds a further service carried by the same connection, with its own handlers and broadcast keys. Call it before
+  // connecting; when the gateway does not support multiplexing, the hosted service gets no requests and its
+  // broadcasts report Offline.
+  HostedService Host(ServiceDesc desc);
+
+  void Connect(std::string const &endpoint, ServiceDesc desc, std::chrono::milliseconds timeout = {});
+  // Returns at once; done is called on the Service's thread once the handshake has completed or failed. A non-zero
+  // timeout bounds the connect and handshake together.
+  void ConnectAsync(
+      std::string const &endpoint,
+      ServiceDesc desc,
+      std::function<void(std::exception_ptr)> done,
+      std::chrono::milliseconds timeout = {});
+  std::future<void> ConnectAsync(std::string const &endpoint, ServiceDesc desc, std::chrono::milliseconds timeout = {});
 
   void Wait();
 };
 
+// Handle to one broadcast key, obtained from Service::Channel. It stays valid as long as the Service does.
+class BroadcastChannel {
+  friend class Service;
+  friend class HostedService;
+  Service *srv = nullptr;
+  std::shared_ptr<Service::KeyState> state;
+
+  BroadcastChannel(Service *srv, std::shared_ptr<Service::KeyState> state) : srv(srv), state(std::move(state)) {}
+
+public:
+  BroadcastChannel() {}
+
+  BroadcastStatus Publish(BufferView data);
+  bool HasSubscribers() const;
+  std::string const &Key() const;
+};
+
+// Handle to a service multiplexed over a Service's connection, obtained from Service::Host. It stays valid as long
+// as the Service does.
+class HostedService {
+  friend class Service;
+  Service *srv   = nullptr;
+  uint32_t index = 0;
+
+  HostedService(Service *srv, uint32_t index) : srv(srv), index(index) {}
+
+public:
+  HostedService() {}
+
+  void RegisterHandler(std::string const &name, Handler handler) { srv->Register(name, std::move(handler), {}, index); }
+  void RegisterHandler(std::string const &name, SyncHandler handler) {
+    srv->Register(name, {}, [=](BufferView const &view) -> Expected<Buffer> { return handler(view); }, index);
+  }
+  template <
+      typename F,
+      std::enable_if_t<std::is_same_v<std::invoke_result_t<F &, BufferView const &>, Expected<Buffer>>, int> = 0>
+  void RegisterHandler(std::string const &name, F handler) {
+    srv->Register(name, {}, std::move(handler), index);
+  }
+
+  BroadcastStatus Broadcast(std::string_view key, BufferView data);
+  BroadcastChannel Channel(std::string_view key);
+  bool HasSubscribers(std::string_view key) { return srv->HasSubscribers(key, index); }
+
+  // Service index carried on the wire; the Service itself has index 0.
+  uint32_t Index() const { return index; }
+};
+
+// Ordered response chunks for one request. Each chunk uses one credit granted by the gateway; when the gateway does
+// not support streaming, chunks are collected and sent as a single Response by End. A writer dropped without End or
+// Fail answers the request with an exception.
+class StreamWriter {
+  friend class Service;
+  Service *srv;
+  uint32_t const id, generation;
+  Service::Gate *gate;
+  bool const chunked;
+  std::mutex mtx;
+  uint32_t credits, seq = 0;
+  bool done = false, cancelled = false;
+  std::string collected;
+  std::function<void()> onWritable;
+
+  StreamWriter(Service *srv, uint32_t id, uint32_t generation, Service::Gate *gate, bool chunked, uint32_t credits)
+      : srv(srv), id(id), generation(generation), gate(gate), chunked(chunked), credits(credits) {}
+
+  void Grant(uint32_t credits);
+  void Cancel();
+  void Finish();
+
+public:
+  StreamWriter(StreamWriter const &) = delete;
+  ~StreamWriter();
+
+  // Sends chunk; returns false without sending when no credit is left or the stream is over or cancelled.
+  bool Write(BufferView chunk);
+  // Sends chunk, if any, as the last one; it needs no credit.
+  void End(BufferView chunk = {});
+  // Ends the stream with an exception instead.
+  void Fail(std::string_view message);
+
+  // Called, possibly on the Service's thread, when credit arrives or the request is cancelled.
+  void OnWritable(std::function<void()> fn);
+  bool Cancelled();
+};
+
+// Incoming parts of a streamed request, in order. At most the upload window of parts is buffered; credit for more
+// is returned to the gateway as they are read. A request that was not streamed arrives as a single last part.
+class StreamReader {
+  friend class Service;
+  using ReadCallback = std::function<void(std::exception_ptr ep, Buffer chunk, bool last)>;
+
+  Service *srv;
+  uint32_t const id, generation;
+  std::mutex mtx;
+  std::deque<Buffer> queued;
+  uint32_t nextSeq = 0, readSeq = 0, consumed = 0;
+  bool received = false, delivered = false;
+  std::exception_ptr ep;
+  ReadCallback waiting;
+
+  StreamReader(Service *srv, uint32_t id, uint32_t generation) : srv(srv), id(id), generation(generation) {}
+
+  void Push(uint32_t seq, Buffer chunk, bool last);
+  void Abort(std::exception_ptr ep);
+
+public:
+  StreamReader(StreamReader const &) = delete;
+
+  // Calls fn with the next part once it is available; only one read may be pending at a time. Reading past the last
+  // part yields an empty last part.
+  void Read(ReadCallback fn);
+};
+
 } // namespace WsGw
\ No newline at end of file
@@ -15,8 +15,12 @@ namespace Service {
 
 struct Handshake;
 
+struct HostedDesc;
+
 struct HandshakeResponse;
 
+struct HostedMethods;
+
 namespace Send {
 
 struct SendPacket;
@@ -27,6 +31,14 @@ struct Exception;
 
 struct Broadcast;
 
+struct BroadcastBatch;
+
+struct BindKey;
+
+struct ResponseChunk;
+
+struct UploadCredit;
+
 }  // namespace Send
 
 namespace Receive {
@@ -37,6 +49,12 @@ struct Request;
 
 struct CancelRequest;
 
+struct SubscriberChange;
+
+struct StreamCredit;
+
+struct RequestChunk;
+
 }  // namespace Receive
 
 namespace Send {
@@ -46,16 +64,24 @@ enum Send {
   Send_Response = 1,
   Send_Exception = 2,
   Send_Broadcast = 3,
+  Send_BroadcastBatch = 4,
+  Send_BindKey = 5,
+  Send_ResponseChunk = 6,
+  Send_UploadCredit = 7,
   Send_MIN = Send_NONE,
-  Send_MAX = Send_Broadcast
+  Send_MAX = Send_UploadCredit
 };
 
-inline const Send (&EnumValuesSend())[4] {
+inline const Send (&EnumValuesSend())[8] {
   static const Send values[] = {
     Send_NONE,
     Send_Response,
     Send_Exception,
-    Send_Broadcast
+    Send_Broadcast,
+    Send_BroadcastBatch,
+    Send_BindKey,
+    Send_ResponseChunk,
+    Send_UploadCredit
   };
   return values;
 }
@@ -66,13 +92,17 @@ inline const char * const *EnumNamesSend() {
     "Response",
     "Exception",
     "Broadcast",
+    "BroadcastBatch",
+    "BindKey",
+    "ResponseChunk",
+    "UploadCredit",
     nullptr
   };
   return names;
 }
 
 inline const char *EnumNameSend(Send e) {
-  if (e < Send_NONE || e > Send_Broadcast) return "";
+  if (e < Send_NONE || e > Send_UploadCredit) return "";
   const size_t index = static_cast<size_t>(e);
   return EnumNamesSend()[index];
 }
@@ -93,6 +123,22 @@ template<> struct SendTraits<Broadcast> {
   static const Send enum_value = Send_Broadcast;
 };
 
+template<> struct SendTraits<BroadcastBatch> {
+  static const Send enum_value = Send_BroadcastBatch;
+};
+
+template<> struct SendTraits<BindKey> {
+  static const Send enum_value = Send_BindKey;
+};
+
+template<> struct SendTraits<ResponseChunk> {
+  static const Send enum_value = Send_ResponseChunk;
+};
+
+template<> struct SendTraits<UploadCredit> {
+  static const Send enum_value = Send_UploadCredit;
+};
+
 bool VerifySend(flatbuffers::Verifier &verifier, const void *obj, Send type);
 bool VerifySendVector(flatbuffers::Verifier &verifier, const flatbuffers::Vector<flatbuffers::Offset<void>> *values, const flatbuffers::Vector<uint8_t> *types);
 
@@ -104,15 +150,21 @@ enum Receive {
   Receive_NONE = 0,
   Receive_Request = 1,
   Receive_CancelRequest = 2,
+  Receive_SubscriberChange = 3,
+  Receive_StreamCredit = 4,
+  Receive_RequestChunk = 5,
   Receive_MIN = Receive_NONE,
-  Receive_MAX = Receive_CancelRequest
+  Receive_MAX = Receive_RequestChunk
 };
 
-inline const Receive (&EnumValuesReceive())[3] {
+inline const Receive (&EnumValuesReceive())[6] {
   static const Receive values[] = {
     Receive_NONE,
     Receive_Request,
-    Receive_CancelRequest
+    Receive_CancelRequest,
+    Receive_SubscriberChange,
+    Receive_StreamCredit,
+    Receive_RequestChunk
   };
   return values;
 }
@@ -122,13 +174,16 @@ inline const char * const *EnumNamesReceive() {
     "NONE",
     "Request",
     "CancelRequest",
+    "SubscriberChange",
+    "StreamCredit",
+    "RequestChunk",
     nullptr
   };
   return names;
 }
 
 inline const char *EnumNameReceive(Receive e) {
-  if (e < Receive_NONE || e > Receive_CancelRequest) return "";
+  if (e < Receive_NONE || e > Receive_RequestChunk) return "";
   const size_t index = static_cast<size_t>(e);
   return EnumNamesReceive()[index];
 }
@@ -145,6 +200,18 @@ template<> struct ReceiveTraits<CancelRequest> {
   static const Receive enum_value = Receive_CancelRequest;
 };
 
+template<> struct ReceiveTraits<SubscriberChange> {
+  static const Receive enum_value = Receive_SubscriberChange;
+};
+
+template<> struct ReceiveTraits<StreamCredit> {
+  static const Receive enum_value = Receive_StreamCredit;
+};
+
+template<> struct ReceiveTraits<RequestChunk> {
+  static const Receive enum_value = Receive_RequestChunk;
+};
+
 bool VerifyReceive(flatbuffers::Verifier &verifier, const void *obj, Receive type);
 bool VerifyReceiveVector(flatbuffers::Verifier &verifier, const flatbuffers::Vector<flatbuffers::Offset<void>> *values, const flatbuffers::Vector<uint8_t> *types);
 
@@ -156,23 +223,66 @@ struct Handshake FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_VERSION = 6,
     VT_NAME = 8,
     VT_TYPE = 10,
-    VT_SRVVER = 12
+    VT_SRVVER = 12,
+    VT_FEATURES = 14,
+    VT_METHODS = 16,
+    VT_UPLOAD_WINDOW = 18,
+    VT_HOSTED = 20
   };
   const flatbuffers::String *magic() const {
     return GetPointer<const flatbuffers::String *>(VT_MAGIC);
   }
+  flatbuffers::String *mutable_magic() {
+    return GetPointer<flatbuffers::String *>(VT_MAGIC);
+  }
   uint32_t version() const {
     return GetField<uint32_t>(VT_VERSION, 0);
   }
+  bool mutate_version(uint32_t _version) {
+    return SetField<uint32_t>(VT_VERSION, _version, 0);
+  }
   const flatbuffers::String *name() const {
     return GetPointer<const flatbuffers::String *>(VT_NAME);
   }
+  flatbuffers::String *mutable_name() {
+    return GetPointer<flatbuffers::String *>(VT_NAME);
+  }
   const flatbuffers::String *type() const {
     return GetPointer<const flatbuffers::String *>(VT_TYPE);
   }
+  flatbuffers::String *mutable_type() {
+    return GetPointer<flatbuffers::String *>(VT_TYPE);
+  }
   const flatbuffers::String *srvver() const {
     return GetPointer<const flatbuffers::String *>(VT_SRVVER);
   }
+  flatbuffers::String *mutable_srvver() {
+    return GetPointer<flatbuffers::String *>(VT_SRVVER);
+  }
+  uint32_t features() const {
+    return GetField<uint32_t>(VT_FEATURES, 0);
+  }
+  bool mutate_features(uint32_t _features) {
+    return SetField<uint32_t>(VT_FEATURES, _features, 0);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *methods() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *>(VT_METHODS);
+  }
+  flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *mutable_methods() {
+    return GetPointer<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *>(VT_METHODS);
+  }
+  uint32_t upload_window() const {
+    return GetField<uint32_t>(VT_UPLOAD_WINDOW, 0);
+  }
+  bool mutate_upload_window(uint32_t _upload_window) {
+    return SetField<uint32_t>(VT_UPLOAD_WINDOW, _upload_window, 0);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<HostedDesc>> *hosted() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<HostedDesc>> *>(VT_HOSTED);
+  }
+  flatbuffers::Vector<flatbuffers::Offset<HostedDesc>> *mutable_hosted() {
+    return GetPointer<flatbuffers::Vector<flatbuffers::Offset<HostedDesc>> *>(VT_HOSTED);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_MAGIC) &&
@@ -184,6 +294,14 @@ struct Handshake FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            verifier.VerifyString(type()) &&
            VerifyOffset(verifier, VT_SRVVER) &&
            verifier.VerifyString(srvver()) &&
+           VerifyField<uint32_t>(verifier, VT_FEATURES) &&
+           VerifyOffset(verifier, VT_METHODS) &&
+           verifier.VerifyVector(methods()) &&
+           verifier.VerifyVectorOfStrings(methods()) &&
+           VerifyField<uint32_t>(verifier, VT_UPLOAD_WINDOW) &&
+           VerifyOffset(verifier, VT_HOSTED) &&
+           verifier.VerifyVector(hosted()) &&
+           verifier.VerifyVectorOfTables(hosted()) &&
            verifier.EndTable();
   }
 };
@@ -206,6 +324,18 @@ struct HandshakeBuilder {
   void add_srvver(flatbuffers::Offset<flatbuffers::String> srvver) {
     fbb_.AddOffset(Handshake::VT_SRVVER, srvver);
   }
+  void add_features(uint32_t features) {
+    fbb_.AddElement<uint32_t>(Handshake::VT_FEATURES, features, 0);
+  }
+  void add_methods(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> methods) {
+    fbb_.AddOffset(Handshake::VT_METHODS, methods);
+  }
+  void add_upload_window(uint32_t upload_window) {
+    fbb_.AddElement<uint32_t>(Handshake::VT_UPLOAD_WINDOW, upload_window, 0);
+  }
+  void add_hosted(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<HostedDesc>>> hosted) {
+    fbb_.AddOffset(Handshake::VT_HOSTED, hosted);
+  }
   explicit HandshakeBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -224,8 +354,16 @@ inline flatbuffers::Offset<Handshake> CreateHandshake(
     uint32_t version = 0,
     flatbuffers::Offset<flatbuffers::String> name = 0,
     flatbuffers::Offset<flatbuffers::String> type = 0,
-    flatbuffers::Offset<flatbuffers::String> srvver = 0) {
+    flatbuffers::Offset<flatbuffers::String> srvver = 0,
+    uint32_t features = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> methods = 0,
+    uint32_t upload_window = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<HostedDesc>>> hosted = 0) {
   HandshakeBuilder builder_(_fbb);
+  builder_.add_hosted(hosted);
+  builder_.add_upload_window(upload_window);
+  builder_.add_methods(methods);
+  builder_.add_features(features);
   builder_.add_srvver(srvver);
   builder_.add_type(type);
   builder_.add_name(name);
@@ -240,31 +378,184 @@ inline flatbuffers::Offset<Handshake> CreateHandshakeDirect(
     uint32_t version = 0,
     const char *name = nullptr,
     const char *type = nullptr,
-    const char *srvver = nullptr) {
+    const char *srvver = nullptr,
+    uint32_t features = 0,
+    const std::vector<flatbuffers::Offset<flatbuffers::String>> *methods = nullptr,
+    uint32_t upload_window = 0,
+    const std::vector<flatbuffers::Offset<HostedDesc>> *hosted = nullptr) {
   auto magic__ = magic ? _fbb.CreateString(magic) : 0;
   auto name__ = name ? _fbb.CreateString(name) : 0;
   auto type__ = type ? _fbb.CreateString(type) : 0;
   auto srvver__ = srvver ? _fbb.CreateString(srvver) : 0;
+  auto methods__ = methods ? _fbb.CreateVector<flatbuffers::Offset<flatbuffers::String>>(*methods) : 0;
+  auto hosted__ = hosted ? _fbb.CreateVector<flatbuffers::Offset<HostedDesc>>(*hosted) : 0;
   return WsGw::proto::Service::CreateHandshake(
       _fbb,
       magic__,
       version,
       name__,
       type__,
-      srvver__);
+      srvver__,
+      features,
+      methods__,
+      upload_window,
+      hosted__);
+}
+
+struct HostedDesc FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_NAME = 4,
+    VT_TYPE = 6,
+    VT_SRVVER = 8,
+    VT_METHODS = 10
+  };
+  const flatbuffers::String *name() const {
+    return GetPointer<const flatbuffers::String *>(VT_NAME);
+  }
+  flatbuffers::String *mutable_name() {
+    return GetPointer<flatbuffers::String *>(VT_NAME);
+  }
+  const flatbuffers::String *type() const {
+    return GetPointer<const flatbuffers::String *>(VT_TYPE);
+  }
+  flatbuffers::String *mutable_type() {
+    return GetPointer<flatbuffers::String *>(VT_TYPE);
+  }
+  const flatbuffers::String *srvver() const {
+    return GetPointer<const flatbuffers::String *>(VT_SRVVER);
+  }
+  flatbuffers::String *mutable_srvver() {
+    return GetPointer<flatbuffers::String *>(VT_SRVVER);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *methods() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *>(VT_METHODS);
+  }
+  flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *mutable_methods() {
+    return GetPointer<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *>(VT_METHODS);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_NAME) &&
+           verifier.VerifyString(name()) &&
+           VerifyOffset(verifier, VT_TYPE) &&
+           verifier.VerifyString(type()) &&
+           VerifyOffset(verifier, VT_SRVVER) &&
+           verifier.VerifyString(srvver()) &&
+           VerifyOffset(verifier, VT_METHODS) &&
+           verifier.VerifyVector(methods()) &&
+           verifier.VerifyVectorOfStrings(methods()) &&
+           verifier.EndTable();
+  }
+};
+
+struct HostedDescBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_name(flatbuffers::Offset<flatbuffers::String> name) {
+    fbb_.AddOffset(HostedDesc::VT_NAME, name);
+  }
+  void add_type(flatbuffers::Offset<flatbuffers::String> type) {
+    fbb_.AddOffset(HostedDesc::VT_TYPE, type);
+  }
+  void add_srvver(flatbuffers::Offset<flatbuffers::String> srvver) {
+    fbb_.AddOffset(HostedDesc::VT_SRVVER, srvver);
+  }
+  void add_methods(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> methods) {
+    fbb_.AddOffset(HostedDesc::VT_METHODS, methods);
+  }
+  explicit HostedDescBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  HostedDescBuilder &operator=(const HostedDescBuilder &);
+  flatbuffers::Offset<HostedDesc> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<HostedDesc>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<HostedDesc> CreateHostedDesc(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> name = 0,
+    flatbuffers::Offset<flatbuffers::String> type = 0,
+    flatbuffers::Offset<flatbuffers::String> srvver = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> methods = 0) {
+  HostedDescBuilder builder_(_fbb);
+  builder_.add_methods(methods);
+  builder_.add_srvver(srvver);
+  builder_.add_type(type);
+  builder_.add_name(name);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<HostedDesc> CreateHostedDescDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *name = nullptr,
+    const char *type = nullptr,
+    const char *srvver = nullptr,
+    const std::vector<flatbuffers::Offset<flatbuffers::String>> *methods = nullptr) {
+  auto name__ = name ? _fbb.CreateString(name) : 0;
+  auto type__ = type ? _fbb.CreateString(type) : 0;
+  auto srvver__ = srvver ? _fbb.CreateString(srvver) : 0;
+  auto methods__ = methods ? _fbb.CreateVector<flatbuffers::Offset<flatbuffers::String>>(*methods) : 0;
+  return WsGw::proto::Service::CreateHostedDesc(
+      _fbb,
+      name__,
+      type__,
+      srvver__,
+      methods__);
 }
 
 struct HandshakeResponse FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
-    VT_MAGIC = 4
+    VT_MAGIC = 4,
+    VT_FEATURES = 6,
+    VT_METHOD_IDS = 8,
+    VT_STREAM_WINDOW = 10,
+    VT_HOSTED = 12
   };
   const flatbuffers::String *magic() const {
     return GetPointer<const flatbuffers::String *>(VT_MAGIC);
   }
+  flatbuffers::String *mutable_magic() {
+    return GetPointer<flatbuffers::String *>(VT_MAGIC);
+  }
+  uint32_t features() const {
+    return GetField<uint32_t>(VT_FEATURES, 0);
+  }
+  bool mutate_features(uint32_t _features) {
+    return SetField<uint32_t>(VT_FEATURES, _features, 0);
+  }
+  const flatbuffers::Vector<uint32_t> *method_ids() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_METHOD_IDS);
+  }
+  flatbuffers::Vector<uint32_t> *mutable_method_ids() {
+    return GetPointer<flatbuffers::Vector<uint32_t> *>(VT_METHOD_IDS);
+  }
+  uint32_t stream_window() const {
+    return GetField<uint32_t>(VT_STREAM_WINDOW, 0);
+  }
+  bool mutate_stream_window(uint32_t _stream_window) {
+    return SetField<uint32_t>(VT_STREAM_WINDOW, _stream_window, 0);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<HostedMethods>> *hosted() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<HostedMethods>> *>(VT_HOSTED);
+  }
+  flatbuffers::Vector<flatbuffers::Offset<HostedMethods>> *mutable_hosted() {
+    return GetPointer<flatbuffers::Vector<flatbuffers::Offset<HostedMethods>> *>(VT_HOSTED);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_MAGIC) &&
            verifier.VerifyString(magic()) &&
+           VerifyField<uint32_t>(verifier, VT_FEATURES) &&
+           VerifyOffset(verifier, VT_METHOD_IDS) &&
+           verifier.VerifyVector(method_ids()) &&
+           VerifyField<uint32_t>(verifier, VT_STREAM_WINDOW) &&
+           VerifyOffset(verifier, VT_HOSTED) &&
+           verifier.VerifyVector(hosted()) &&
+           verifier.VerifyVectorOfTables(hosted()) &&
            verifier.EndTable();
   }
 };
@@ -275,6 +566,18 @@ struct HandshakeResponseBuilder {
   void add_magic(flatbuffers::Offset<flatbuffers::String> magic) {
     fbb_.AddOffset(HandshakeResponse::VT_MAGIC, magic);
   }
+  void add_features(uint32_t features) {
+    fbb_.AddElement<uint32_t>(HandshakeResponse::VT_FEATURES, features, 0);
+  }
+  void add_method_ids(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> method_ids) {
+    fbb_.AddOffset(HandshakeResponse::VT_METHOD_IDS, method_ids);
+  }
+  void add_stream_window(uint32_t stream_window) {
+    fbb_.AddElement<uint32_t>(HandshakeResponse::VT_STREAM_WINDOW, stream_window, 0);
+  }
+  void add_hosted(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<HostedMethods>>> hosted) {
+    fbb_.AddOffset(HandshakeResponse::VT_HOSTED, hosted);
+  }
   explicit HandshakeResponseBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -289,19 +592,90 @@ struct HandshakeResponseBuilder {
 
 inline flatbuffers::Offset<HandshakeResponse> CreateHandshakeResponse(
     flatbuffers::FlatBufferBuilder &_fbb,
-    flatbuffers::Offset<flatbuffers::String> magic = 0) {
+    flatbuffers::Offset<flatbuffers::String> magic = 0,
+    uint32_t features = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> method_ids = 0,
+    uint32_t stream_window = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<HostedMethods>>> hosted = 0) {
   HandshakeResponseBuilder builder_(_fbb);
+  builder_.add_hosted(hosted);
+  builder_.add_stream_window(stream_window);
+  builder_.add_method_ids(method_ids);
+  builder_.add_features(features);
   builder_.add_magic(magic);
   return builder_.Finish();
 }
 
 inline flatbuffers::Offset<HandshakeResponse> CreateHandshakeResponseDirect(
     flatbuffers::FlatBufferBuilder &_fbb,
-    const char *magic = nullptr) {
+    const char *magic = nullptr,
+    uint32_t features = 0,
+    const std::vector<uint32_t> *method_ids = nullptr,
+    uint32_t stream_window = 0,
+    const std::vector<flatbuffers::Offset<HostedMethods>> *hosted = nullptr) {
   auto magic__ = magic ? _fbb.CreateString(magic) : 0;
+  auto method_ids__ = method_ids ? _fbb.CreateVector<uint32_t>(*method_ids) : 0;
+  auto hosted__ = hosted ? _fbb.CreateVector<flatbuffers::Offset<HostedMethods>>(*hosted) : 0;
   return WsGw::proto::Service::CreateHandshakeResponse(
       _fbb,
-      magic__);
+      magic__,
+      features,
+      method_ids__,
+      stream_window,
+      hosted__);
+}
+
+struct HostedMethods FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_METHOD_IDS = 4
+  };
+  const flatbuffers::Vector<uint32_t> *method_ids() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_METHOD_IDS);
+  }
+  flatbuffers::Vector<uint32_t> *mutable_method_ids() {
+    return GetPointer<flatbuffers::Vector<uint32_t> *>(VT_METHOD_IDS);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_METHOD_IDS) &&
+           verifier.VerifyVector(method_ids()) &&
+           verifier.EndTable();
+  }
+};
+
+struct HostedMethodsBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_method_ids(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> method_ids) {
+    fbb_.AddOffset(HostedMethods::VT_METHOD_IDS, method_ids);
+  }
+  explicit HostedMethodsBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  HostedMethodsBuilder &operator=(const HostedMethodsBuilder &);
+  flatbuffers::Offset<HostedMethods> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<HostedMethods>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<HostedMethods> CreateHostedMethods(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> method_ids = 0) {
+  HostedMethodsBuilder builder_(_fbb);
+  builder_.add_method_ids(method_ids);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<HostedMethods> CreateHostedMethodsDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<uint32_t> *method_ids = nullptr) {
+  auto method_ids__ = method_ids ? _fbb.CreateVector<uint32_t>(*method_ids) : 0;
+  return WsGw::proto::Service::CreateHostedMethods(
+      _fbb,
+      method_ids__);
 }
 
 namespace Send {
@@ -327,6 +701,21 @@ struct SendPacket FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const Broadcast *packet_as_Broadcast() const {
     return packet_type() == Send_Broadcast ? static_cast<const Broadcast *>(packet()) : nullptr;
   }
+  const BroadcastBatch *packet_as_BroadcastBatch() const {
+    return packet_type() == Send_BroadcastBatch ? static_cast<const BroadcastBatch *>(packet()) : nullptr;
+  }
+  const BindKey *packet_as_BindKey() const {
+    return packet_type() == Send_BindKey ? static_cast<const BindKey *>(packet()) : nullptr;
+  }
+  const ResponseChunk *packet_as_ResponseChunk() const {
+    return packet_type() == Send_ResponseChunk ? static_cast<const ResponseChunk *>(packet()) : nullptr;
+  }
+  const UploadCredit *packet_as_UploadCredit() const {
+    return packet_type() == Send_UploadCredit ? static_cast<const UploadCredit *>(packet()) : nullptr;
+  }
+  void *mutable_packet() {
+    return GetPointer<void *>(VT_PACKET);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint8_t>(verifier, VT_PACKET_TYPE) &&
@@ -348,6 +737,22 @@ template<> inline const Broadcast *SendPacket::packet_as<Broadcast>() const {
   return packet_as_Broadcast();
 }
 
+template<> inline const BroadcastBatch *SendPacket::packet_as<BroadcastBatch>() const {
+  return packet_as_BroadcastBatch();
+}
+
+template<> inline const BindKey *SendPacket::packet_as<BindKey>() const {
+  return packet_as_BindKey();
+}
+
+template<> inline const ResponseChunk *SendPacket::packet_as<ResponseChunk>() const {
+  return packet_as_ResponseChunk();
+}
+
+template<> inline const UploadCredit *SendPacket::packet_as<UploadCredit>() const {
+  return packet_as_UploadCredit();
+}
+
 struct SendPacketBuilder {
   flatbuffers::FlatBufferBuilder &fbb_;
   flatbuffers::uoffset_t start_;
@@ -387,9 +792,15 @@ struct Response FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   uint32_t id() const {
     return GetField<uint32_t>(VT_ID, 0);
   }
+  bool mutate_id(uint32_t _id) {
+    return SetField<uint32_t>(VT_ID, _id, 0);
+  }
   const flatbuffers::Vector<uint8_t> *payload() const {
     return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_PAYLOAD);
   }
+  flatbuffers::Vector<uint8_t> *mutable_payload() {
+    return GetPointer<flatbuffers::Vector<uint8_t> *>(VT_PAYLOAD);
+  }
   flexbuffers::Reference payload_flexbuffer_root() const {
     return flexbuffers::GetRoot(payload()->Data(), payload()->size());
   }
@@ -452,9 +863,15 @@ struct Exception FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   uint32_t id() const {
     return GetField<uint32_t>(VT_ID, 0);
   }
+  bool mutate_id(uint32_t _id) {
+    return SetField<uint32_t>(VT_ID, _id, 0);
+  }
   const WsGw::proto::ExceptionInfo *info() const {
     return GetPointer<const WsGw::proto::ExceptionInfo *>(VT_INFO);
   }
+  WsGw::proto::ExceptionInfo *mutable_info() {
+    return GetPointer<WsGw::proto::ExceptionInfo *>(VT_INFO);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint32_t>(verifier, VT_ID) &&
@@ -498,23 +915,45 @@ inline flatbuffers::Offset<Exception> CreateException(
 struct Broadcast FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_KEY = 4,
-    VT_PAYLOAD = 6
+    VT_PAYLOAD = 6,
+    VT_KEY_ID = 8,
+    VT_SERVICE = 10
   };
   const flatbuffers::String *key() const {
     return GetPointer<const flatbuffers::String *>(VT_KEY);
   }
+  flatbuffers::String *mutable_key() {
+    return GetPointer<flatbuffers::String *>(VT_KEY);
+  }
   const flatbuffers::Vector<uint8_t> *payload() const {
     return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_PAYLOAD);
   }
+  flatbuffers::Vector<uint8_t> *mutable_payload() {
+    return GetPointer<flatbuffers::Vector<uint8_t> *>(VT_PAYLOAD);
+  }
   flexbuffers::Reference payload_flexbuffer_root() const {
     return flexbuffers::GetRoot(payload()->Data(), payload()->size());
   }
+  uint32_t key_id() const {
+    return GetField<uint32_t>(VT_KEY_ID, 0);
+  }
+  bool mutate_key_id(uint32_t _key_id) {
+    return SetField<uint32_t>(VT_KEY_ID, _key_id, 0);
+  }
+  uint32_t service() const {
+    return GetField<uint32_t>(VT_SERVICE, 0);
+  }
+  bool mutate_service(uint32_t _service) {
+    return SetField<uint32_t>(VT_SERVICE, _service, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_KEY) &&
            verifier.VerifyString(key()) &&
            VerifyOffset(verifier, VT_PAYLOAD) &&
            verifier.VerifyVector(payload()) &&
+           VerifyField<uint32_t>(verifier, VT_KEY_ID) &&
+           VerifyField<uint32_t>(verifier, VT_SERVICE) &&
            verifier.EndTable();
   }
 };
@@ -528,6 +967,12 @@ struct BroadcastBuilder {
   void add_payload(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> payload) {
     fbb_.AddOffset(Broadcast::VT_PAYLOAD, payload);
   }
+  void add_key_id(uint32_t key_id) {
+    fbb_.AddElement<uint32_t>(Broadcast::VT_KEY_ID, key_id, 0);
+  }
+  void add_service(uint32_t service) {
+    fbb_.AddElement<uint32_t>(Broadcast::VT_SERVICE, service, 0);
+  }
   explicit BroadcastBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -543,8 +988,12 @@ struct BroadcastBuilder {
 inline flatbuffers::Offset<Broadcast> CreateBroadcast(
     flatbuffers::FlatBufferBuilder &_fbb,
     flatbuffers::Offset<flatbuffers::String> key = 0,
-    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> payload = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> payload = 0,
+    uint32_t key_id = 0,
+    uint32_t service = 0) {
   BroadcastBuilder builder_(_fbb);
+  builder_.add_service(service);
+  builder_.add_key_id(key_id);
   builder_.add_payload(payload);
   builder_.add_key(key);
   return builder_.Finish();
@@ -553,162 +1002,535 @@ inline flatbuffers::Offset<Broadcast> CreateBroadcast(
 inline flatbuffers::Offset<Broadcast> CreateBroadcastDirect(
     flatbuffers::FlatBufferBuilder &_fbb,
     const char *key = nullptr,
-    const std::vector<uint8_t> *payload = nullptr) {
+    const std::vector<uint8_t> *payload = nullptr,
+    uint32_t key_id = 0,
+    uint32_t service = 0) {
   auto key__ = key ? _fbb.CreateString(key) : 0;
   auto payload__ = payload ? _fbb.CreateVector<uint8_t>(*payload) : 0;
   return WsGw::proto::Service::Send::CreateBroadcast(
       _fbb,
       key__,
-      payload__);
+      payload__,
+      key_id,
+      service);
 }
 
-}  // namespace Send
-
-namespace Receive {
-
-struct ReceivePacket FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+struct BroadcastBatch FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
-    VT_PACKET_TYPE = 4,
-    VT_PACKET = 6
+    VT_ITEMS = 4
   };
-  Receive packet_type() const {
-    return static_cast<Receive>(GetField<uint8_t>(VT_PACKET_TYPE, 0));
-  }
-  const void *packet() const {
-    return GetPointer<const void *>(VT_PACKET);
+  const flatbuffers::Vector<flatbuffers::Offset<Broadcast>> *items() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<Broadcast>> *>(VT_ITEMS);
   }
-  template<typename T> const T *packet_as() const;
-  const Request *packet_as_Request() const {
-    return packet_type() == Receive_Request ? static_cast<const Request *>(packet()) : nullptr;
-  }
-  const CancelRequest *packet_as_CancelRequest() const {
-    return packet_type() == Receive_CancelRequest ? static_cast<const CancelRequest *>(packet()) : nullptr;
+  flatbuffers::Vector<flatbuffers::Offset<Broadcast>> *mutable_items() {
+    return GetPointer<flatbuffers::Vector<flatbuffers::Offset<Broadcast>> *>(VT_ITEMS);
   }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
-           VerifyField<uint8_t>(verifier, VT_PACKET_TYPE) &&
-           VerifyOffset(verifier, VT_PACKET) &&
-           VerifyReceive(verifier, packet(), packet_type()) &&
+           VerifyOffset(verifier, VT_ITEMS) &&
+           verifier.VerifyVector(items()) &&
+           verifier.VerifyVectorOfTables(items()) &&
            verifier.EndTable();
   }
 };
 
-template<> inline const Request *ReceivePacket::packet_as<Request>() const {
-  return packet_as_Request();
-}
-
-template<> inline const CancelRequest *ReceivePacket::packet_as<CancelRequest>() const {
-  return packet_as_CancelRequest();
-}
-
-struct ReceivePacketBuilder {
+struct BroadcastBatchBuilder {
   flatbuffers::FlatBufferBuilder &fbb_;
   flatbuffers::uoffset_t start_;
-  void add_packet_type(Receive packet_type) {
-    fbb_.AddElement<uint8_t>(ReceivePacket::VT_PACKET_TYPE, static_cast<uint8_t>(packet_type), 0);
+  void add_items(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<Broadcast>>> items) {
+    fbb_.AddOffset(BroadcastBatch::VT_ITEMS, items);
   }
-  void add_packet(flatbuffers::Offset<void> packet) {
-    fbb_.AddOffset(ReceivePacket::VT_PACKET, packet);
-  }
-  explicit ReceivePacketBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+  explicit BroadcastBatchBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
-  ReceivePacketBuilder &operator=(const ReceivePacketBuilder &);
-  flatbuffers::Offset<ReceivePacket> Finish() {
+  BroadcastBatchBuilder &operator=(const BroadcastBatchBuilder &);
+  flatbuffers::Offset<BroadcastBatch> Finish() {
     const auto end = fbb_.EndTable(start_);
-    auto o = flatbuffers::Offset<ReceivePacket>(end);
+    auto o = flatbuffers::Offset<BroadcastBatch>(end);
     return o;
   }
 };
 
-inline flatbuffers::Offset<ReceivePacket> CreateReceivePacket(
+inline flatbuffers::Offset<BroadcastBatch> CreateBroadcastBatch(
     flatbuffers::FlatBufferBuilder &_fbb,
-    Receive packet_type = Receive_NONE,
-    flatbuffers::Offset<void> packet = 0) {
-  ReceivePacketBuilder builder_(_fbb);
-  builder_.add_packet(packet);
-  builder_.add_packet_type(packet_type);
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<Broadcast>>> items = 0) {
+  BroadcastBatchBuilder builder_(_fbb);
+  builder_.add_items(items);
   return builder_.Finish();
 }
 
-struct Request FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+inline flatbuffers::Offset<BroadcastBatch> CreateBroadcastBatchDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<flatbuffers::Offset<Broadcast>> *items = nullptr) {
+  auto items__ = items ? _fbb.CreateVector<flatbuffers::Offset<Broadcast>>(*items) : 0;
+  return WsGw::proto::Service::Send::CreateBroadcastBatch(
+      _fbb,
+      items__);
+}
+
+struct BindKey FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_KEY = 4,
     VT_ID = 6,
-    VT_PAYLOAD = 8
+    VT_SERVICE = 8
   };
   const flatbuffers::String *key() const {
     return GetPointer<const flatbuffers::String *>(VT_KEY);
   }
+  flatbuffers::String *mutable_key() {
+    return GetPointer<flatbuffers::String *>(VT_KEY);
+  }
   uint32_t id() const {
     return GetField<uint32_t>(VT_ID, 0);
   }
-  const flatbuffers::Vector<uint8_t> *payload() const {
-    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_PAYLOAD);
+  bool mutate_id(uint32_t _id) {
+    return SetField<uint32_t>(VT_ID, _id, 0);
   }
-  flexbuffers::Reference payload_flexbuffer_root() const {
-    return flexbuffers::GetRoot(payload()->Data(), payload()->size());
+  uint32_t service() const {
+    return GetField<uint32_t>(VT_SERVICE, 0);
+  }
+  bool mutate_service(uint32_t _service) {
+    return SetField<uint32_t>(VT_SERVICE, _service, 0);
   }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_KEY) &&
            verifier.VerifyString(key()) &&
            VerifyField<uint32_t>(verifier, VT_ID) &&
-           VerifyOffset(verifier, VT_PAYLOAD) &&
-           verifier.VerifyVector(payload()) &&
+           VerifyField<uint32_t>(verifier, VT_SERVICE) &&
            verifier.EndTable();
   }
 };
 
-struct RequestBuilder {
+struct BindKeyBuilder {
   flatbuffers::FlatBufferBuilder &fbb_;
   flatbuffers::uoffset_t start_;
   void add_key(flatbuffers::Offset<flatbuffers::String> key) {
-    fbb_.AddOffset(Request::VT_KEY, key);
+    fbb_.AddOffset(BindKey::VT_KEY, key);
   }
   void add_id(uint32_t id) {
-    fbb_.AddElement<uint32_t>(Request::VT_ID, id, 0);
+    fbb_.AddElement<uint32_t>(BindKey::VT_ID, id, 0);
   }
-  void add_payload(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> payload) {
-    fbb_.AddOffset(Request::VT_PAYLOAD, payload);
+  void add_service(uint32_t service) {
+    fbb_.AddElement<uint32_t>(BindKey::VT_SERVICE, service, 0);
   }
-  explicit RequestBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+  explicit BindKeyBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
-  RequestBuilder &operator=(const RequestBuilder &);
-  flatbuffers::Offset<Request> Finish() {
+  BindKeyBuilder &operator=(const BindKeyBuilder &);
+  flatbuffers::Offset<BindKey> Finish() {
     const auto end = fbb_.EndTable(start_);
-    auto o = flatbuffers::Offset<Request>(end);
+    auto o = flatbuffers::Offset<BindKey>(end);
     return o;
   }
 };
 
-inline flatbuffers::Offset<Request> CreateRequest(
+inline flatbuffers::Offset<BindKey> CreateBindKey(
     flatbuffers::FlatBufferBuilder &_fbb,
     flatbuffers::Offset<flatbuffers::String> key = 0,
     uint32_t id = 0,
-    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> payload = 0) {
-  RequestBuilder builder_(_fbb);
-  builder_.add_payload(payload);
+    uint32_t service = 0) {
+  BindKeyBuilder builder_(_fbb);
+  builder_.add_service(service);
   builder_.add_id(id);
   builder_.add_key(key);
   return builder_.Finish();
 }
 
-inline flatbuffers::Offset<Request> CreateRequestDirect(
+inline flatbuffers::Offset<BindKey> CreateBindKeyDirect(
     flatbuffers::FlatBufferBuilder &_fbb,
     const char *key = nullptr,
     uint32_t id = 0,
-    const std::vector<uint8_t> *payload = nullptr) {
+    uint32_t service = 0) {
   auto key__ = key ? _fbb.CreateString(key) : 0;
-  auto payload__ = payload ? _fbb.CreateVector<uint8_t>(*payload) : 0;
-  return WsGw::proto::Service::Receive::CreateRequest(
+  return WsGw::proto::Service::Send::CreateBindKey(
       _fbb,
       key__,
       id,
-      payload__);
+      service);
+}
+
+struct ResponseChunk FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_ID = 4,
+    VT_SEQ = 6,
+    VT_PAYLOAD = 8,
+    VT_LAST = 10
+  };
+  uint32_t id() const {
+    return GetField<uint32_t>(VT_ID, 0);
+  }
+  bool mutate_id(uint32_t _id) {
+    return SetField<uint32_t>(VT_ID, _id, 0);
+  }
+  uint32_t seq() const {
+    return GetField<uint32_t>(VT_SEQ, 0);
+  }
+  bool mutate_seq(uint32_t _seq) {
+    return SetField<uint32_t>(VT_SEQ, _seq, 0);
+  }
+  const flatbuffers::Vector<uint8_t> *payload() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_PAYLOAD);
+  }
+  flatbuffers::Vector<uint8_t> *mutable_payload() {
+    return GetPointer<flatbuffers::Vector<uint8_t> *>(VT_PAYLOAD);
+  }
+  bool last() const {
+    return GetField<uint8_t>(VT_LAST, 0) != 0;
+  }
+  bool mutate_last(bool _last) {
+    return SetField<uint8_t>(VT_LAST, static_cast<uint8_t>(_last), 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_ID) &&
+           VerifyField<uint32_t>(verifier, VT_SEQ) &&
+           VerifyOffset(verifier, VT_PAYLOAD) &&
+           verifier.VerifyVector(payload()) &&
+           VerifyField<uint8_t>(verifier, VT_LAST) &&
+           verifier.EndTable();
+  }
+};
+
+struct ResponseChunkBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_id(uint32_t id) {
+    fbb_.AddElement<uint32_t>(ResponseChunk::VT_ID, id, 0);
+  }
+  void add_seq(uint32_t seq) {
+    fbb_.AddElement<uint32_t>(ResponseChunk::VT_SEQ, seq, 0);
+  }
+  void add_payload(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> payload) {
+    fbb_.AddOffset(ResponseChunk::VT_PAYLOAD, payload);
+  }
+  void add_last(bool last) {
+    fbb_.AddElement<uint8_t>(ResponseChunk::VT_LAST, static_cast<uint8_t>(last), 0);
+  }
+  explicit ResponseChunkBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ResponseChunkBuilder &operator=(const ResponseChunkBuilder &);
+  flatbuffers::Offset<ResponseChunk> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<ResponseChunk>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<ResponseChunk> CreateResponseChunk(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t id = 0,
+    uint32_t seq = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> payload = 0,
+    bool last = false) {
+  ResponseChunkBuilder builder_(_fbb);
+  builder_.add_payload(payload);
+  builder_.add_seq(seq);
+  builder_.add_id(id);
+  builder_.add_last(last);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<ResponseChunk> CreateResponseChunkDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t id = 0,
+    uint32_t seq = 0,
+    const std::vector<uint8_t> *payload = nullptr,
+    bool last = false) {
+  auto payload__ = payload ? _fbb.CreateVector<uint8_t>(*payload) : 0;
+  return WsGw::proto::Service::Send::CreateResponseChunk(
+      _fbb,
+      id,
+      seq,
+      payload__,
+      last);
+}
+
+struct UploadCredit FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_ID = 4,
+    VT_CREDITS = 6
+  };
+  uint32_t id() const {
+    return GetField<uint32_t>(VT_ID, 0);
+  }
+  bool mutate_id(uint32_t _id) {
+    return SetField<uint32_t>(VT_ID, _id, 0);
+  }
+  uint32_t credits() const {
+    return GetField<uint32_t>(VT_CREDITS, 0);
+  }
+  bool mutate_credits(uint32_t _credits) {
+    return SetField<uint32_t>(VT_CREDITS, _credits, 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_ID) &&
+           VerifyField<uint32_t>(verifier, VT_CREDITS) &&
+           verifier.EndTable();
+  }
+};
+
+struct UploadCreditBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_id(uint32_t id) {
+    fbb_.AddElement<uint32_t>(UploadCredit::VT_ID, id, 0);
+  }
+  void add_credits(uint32_t credits) {
+    fbb_.AddElement<uint32_t>(UploadCredit::VT_CREDITS, credits, 0);
+  }
+  explicit UploadCreditBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  UploadCreditBuilder &operator=(const UploadCreditBuilder &);
+  flatbuffers::Offset<UploadCredit> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<UploadCredit>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<UploadCredit> CreateUploadCredit(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t id = 0,
+    uint32_t credits = 0) {
+  UploadCreditBuilder builder_(_fbb);
+  builder_.add_credits(credits);
+  builder_.add_id(id);
+  return builder_.Finish();
+}
+
+}  // namespace Send
+
+namespace Receive {
+
+struct ReceivePacket FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_PACKET_TYPE = 4,
+    VT_PACKET = 6
+  };
+  Receive packet_type() const {
+    return static_cast<Receive>(GetField<uint8_t>(VT_PACKET_TYPE, 0));
+  }
+  const void *packet() const {
+    return GetPointer<const void *>(VT_PACKET);
+  }
+  template<typename T> const T *packet_as() const;
+  const Request *packet_as_Request() const {
+    return packet_type() == Receive_Request ? static_cast<const Request *>(packet()) : nullptr;
+  }
+  const CancelRequest *packet_as_CancelRequest() const {
+    return packet_type() == Receive_CancelRequest ? static_cast<const CancelRequest *>(packet()) : nullptr;
+  }
+  const SubscriberChange *packet_as_SubscriberChange() const {
+    return packet_type() == Receive_SubscriberChange ? static_cast<const SubscriberChange *>(packet()) : nullptr;
+  }
+  const StreamCredit *packet_as_StreamCredit() const {
+    return packet_type() == Receive_StreamCredit ? static_cast<const StreamCredit *>(packet()) : nullptr;
+  }
+  const RequestChunk *packet_as_RequestChunk() const {
+    return packet_type() == Receive_RequestChunk ? static_cast<const RequestChunk *>(packet()) : nullptr;
+  }
+  void *mutable_packet() {
+    return GetPointer<void *>(VT_PACKET);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint8_t>(verifier, VT_PACKET_TYPE) &&
+           VerifyOffset(verifier, VT_PACKET) &&
+           VerifyReceive(verifier, packet(), packet_type()) &&
+           verifier.EndTable();
+  }
+};
+
+template<> inline const Request *ReceivePacket::packet_as<Request>() const {
+  return packet_as_Request();
+}
+
+template<> inline const CancelRequest *ReceivePacket::packet_as<CancelRequest>() const {
+  return packet_as_CancelRequest();
+}
+
+template<> inline const SubscriberChange *ReceivePacket::packet_as<SubscriberChange>() const {
+  return packet_as_SubscriberChange();
+}
+
+template<> inline const StreamCredit *ReceivePacket::packet_as<StreamCredit>() const {
+  return packet_as_StreamCredit();
+}
+
+template<> inline const RequestChunk *ReceivePacket::packet_as<RequestChunk>() const {
+  return packet_as_RequestChunk();
+}
+
+struct ReceivePacketBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_packet_type(Receive packet_type) {
+    fbb_.AddElement<uint8_t>(ReceivePacket::VT_PACKET_TYPE, static_cast<uint8_t>(packet_type), 0);
+  }
+  void add_packet(flatbuffers::Offset<void> packet) {
+    fbb_.AddOffset(ReceivePacket::VT_PACKET, packet);
+  }
+  explicit ReceivePacketBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ReceivePacketBuilder &operator=(const ReceivePacketBuilder &);
+  flatbuffers::Offset<ReceivePacket> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<ReceivePacket>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<ReceivePacket> CreateReceivePacket(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    Receive packet_type = Receive_NONE,
+    flatbuffers::Offset<void> packet = 0) {
+  ReceivePacketBuilder builder_(_fbb);
+  builder_.add_packet(packet);
+  builder_.add_packet_type(packet_type);
+  return builder_.Finish();
+}
+
+struct Request FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_KEY = 4,
+    VT_ID = 6,
+    VT_PAYLOAD = 8,
+    VT_METHOD = 10,
+    VT_STREAMED = 12,
+    VT_SERVICE = 14
+  };
+  const flatbuffers::String *key() const {
+    return GetPointer<const flatbuffers::String *>(VT_KEY);
+  }
+  flatbuffers::String *mutable_key() {
+    return GetPointer<flatbuffers::String *>(VT_KEY);
+  }
+  uint32_t id() const {
+    return GetField<uint32_t>(VT_ID, 0);
+  }
+  bool mutate_id(uint32_t _id) {
+    return SetField<uint32_t>(VT_ID, _id, 0);
+  }
+  const flatbuffers::Vector<uint8_t> *payload() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_PAYLOAD);
+  }
+  flatbuffers::Vector<uint8_t> *mutable_payload() {
+    return GetPointer<flatbuffers::Vector<uint8_t> *>(VT_PAYLOAD);
+  }
+  flexbuffers::Reference payload_flexbuffer_root() const {
+    return flexbuffers::GetRoot(payload()->Data(), payload()->size());
+  }
+  uint32_t method() const {
+    return GetField<uint32_t>(VT_METHOD, 0);
+  }
+  bool mutate_method(uint32_t _method) {
+    return SetField<uint32_t>(VT_METHOD, _method, 0);
+  }
+  bool streamed() const {
+    return GetField<uint8_t>(VT_STREAMED, 0) != 0;
+  }
+  bool mutate_streamed(bool _streamed) {
+    return SetField<uint8_t>(VT_STREAMED, static_cast<uint8_t>(_streamed), 0);
+  }
+  uint32_t service() const {
+    return GetField<uint32_t>(VT_SERVICE, 0);
+  }
+  bool mutate_service(uint32_t _service) {
+    return SetField<uint32_t>(VT_SERVICE, _service, 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_KEY) &&
+           verifier.VerifyString(key()) &&
+           VerifyField<uint32_t>(verifier, VT_ID) &&
+           VerifyOffset(verifier, VT_PAYLOAD) &&
+           verifier.VerifyVector(payload()) &&
+           VerifyField<uint32_t>(verifier, VT_METHOD) &&
+           VerifyField<uint8_t>(verifier, VT_STREAMED) &&
+           VerifyField<uint32_t>(verifier, VT_SERVICE) &&
+           verifier.EndTable();
+  }
+};
+
+struct RequestBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_key(flatbuffers::Offset<flatbuffers::String> key) {
+    fbb_.AddOffset(Request::VT_KEY, key);
+  }
+  void add_id(uint32_t id) {
+    fbb_.AddElement<uint32_t>(Request::VT_ID, id, 0);
+  }
+  void add_payload(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> payload) {
+    fbb_.AddOffset(Request::VT_PAYLOAD, payload);
+  }
+  void add_method(uint32_t method) {
+    fbb_.AddElement<uint32_t>(Request::VT_METHOD, method, 0);
+  }
+  void add_streamed(bool streamed) {
+    fbb_.AddElement<uint8_t>(Request::VT_STREAMED, static_cast<uint8_t>(streamed), 0);
+  }
+  void add_service(uint32_t service) {
+    fbb_.AddElement<uint32_t>(Request::VT_SERVICE, service, 0);
+  }
+  explicit RequestBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  RequestBuilder &operator=(const RequestBuilder &);
+  flatbuffers::Offset<Request> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<Request>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<Request> CreateRequest(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> key = 0,
+    uint32_t id = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> payload = 0,
+    uint32_t method = 0,
+    bool streamed = false,
+    uint32_t service = 0) {
+  RequestBuilder builder_(_fbb);
+  builder_.add_service(service);
+  builder_.add_method(method);
+  builder_.add_payload(payload);
+  builder_.add_id(id);
+  builder_.add_key(key);
+  builder_.add_streamed(streamed);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<Request> CreateRequestDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *key = nullptr,
+    uint32_t id = 0,
+    const std::vector<uint8_t> *payload = nullptr,
+    uint32_t method = 0,
+    bool streamed = false,
+    uint32_t service = 0) {
+  auto key__ = key ? _fbb.CreateString(key) : 0;
+  auto payload__ = payload ? _fbb.CreateVector<uint8_t>(*payload) : 0;
+  return WsGw::proto::Service::Receive::CreateRequest(
+      _fbb,
+      key__,
+      id,
+      payload__,
+      method,
+      streamed,
+      service);
 }
 
 struct CancelRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
@@ -718,6 +1540,9 @@ struct CancelRequest FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   uint32_t id() const {
     return GetField<uint32_t>(VT_ID, 0);
   }
+  bool mutate_id(uint32_t _id) {
+    return SetField<uint32_t>(VT_ID, _id, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint32_t>(verifier, VT_ID) &&
@@ -751,6 +1576,243 @@ inline flatbuffers::Offset<CancelRequest> CreateCancelRequest(
   return builder_.Finish();
 }
 
+struct SubscriberChange FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_KEY = 4,
+    VT_ACTIVE = 6,
+    VT_SERVICE = 8
+  };
+  const flatbuffers::String *key() const {
+    return GetPointer<const flatbuffers::String *>(VT_KEY);
+  }
+  flatbuffers::String *mutable_key() {
+    return GetPointer<flatbuffers::String *>(VT_KEY);
+  }
+  bool active() const {
+    return GetField<uint8_t>(VT_ACTIVE, 0) != 0;
+  }
+  bool mutate_active(bool _active) {
+    return SetField<uint8_t>(VT_ACTIVE, static_cast<uint8_t>(_active), 0);
+  }
+  uint32_t service() const {
+    return GetField<uint32_t>(VT_SERVICE, 0);
+  }
+  bool mutate_service(uint32_t _service) {
+    return SetField<uint32_t>(VT_SERVICE, _service, 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_KEY) &&
+           verifier.VerifyString(key()) &&
+           VerifyField<uint8_t>(verifier, VT_ACTIVE) &&
+           VerifyField<uint32_t>(verifier, VT_SERVICE) &&
+           verifier.EndTable();
+  }
+};
+
+struct SubscriberChangeBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_key(flatbuffers::Offset<flatbuffers::String> key) {
+    fbb_.AddOffset(SubscriberChange::VT_KEY, key);
+  }
+  void add_active(bool active) {
+    fbb_.AddElement<uint8_t>(SubscriberChange::VT_ACTIVE, static_cast<uint8_t>(active), 0);
+  }
+  void add_service(uint32_t service) {
+    fbb_.AddElement<uint32_t>(SubscriberChange::VT_SERVICE, service, 0);
+  }
+  explicit SubscriberChangeBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  SubscriberChangeBuilder &operator=(const SubscriberChangeBuilder &);
+  flatbuffers::Offset<SubscriberChange> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<SubscriberChange>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<SubscriberChange> CreateSubscriberChange(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> key = 0,
+    bool active = false,
+    uint32_t service = 0) {
+  SubscriberChangeBuilder builder_(_fbb);
+  builder_.add_service(service);
+  builder_.add_key(key);
+  builder_.add_active(active);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<SubscriberChange> CreateSubscriberChangeDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *key = nullptr,
+    bool active = false,
+    uint32_t service = 0) {
+  auto key__ = key ? _fbb.CreateString(key) : 0;
+  return WsGw::proto::Service::Receive::CreateSubscriberChange(
+      _fbb,
+      key__,
+      active,
+      service);
+}
+
+struct StreamCredit FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_ID = 4,
+    VT_CREDITS = 6
+  };
+  uint32_t id() const {
+    return GetField<uint32_t>(VT_ID, 0);
+  }
+  bool mutate_id(uint32_t _id) {
+    return SetField<uint32_t>(VT_ID, _id, 0);
+  }
+  uint32_t credits() const {
+    return GetField<uint32_t>(VT_CREDITS, 0);
+  }
+  bool mutate_credits(uint32_t _credits) {
+    return SetField<uint32_t>(VT_CREDITS, _credits, 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_ID) &&
+           VerifyField<uint32_t>(verifier, VT_CREDITS) &&
+           verifier.EndTable();
+  }
+};
+
+struct StreamCreditBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_id(uint32_t id) {
+    fbb_.AddElement<uint32_t>(StreamCredit::VT_ID, id, 0);
+  }
+  void add_credits(uint32_t credits) {
+    fbb_.AddElement<uint32_t>(StreamCredit::VT_CREDITS, credits, 0);
+  }
+  explicit StreamCreditBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  StreamCreditBuilder &operator=(const StreamCreditBuilder &);
+  flatbuffers::Offset<StreamCredit> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<StreamCredit>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<StreamCredit> CreateStreamCredit(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t id = 0,
+    uint32_t credits = 0) {
+  StreamCreditBuilder builder_(_fbb);
+  builder_.add_credits(credits);
+  builder_.add_id(id);
+  return builder_.Finish();
+}
+
+struct RequestChunk FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_ID = 4,
+    VT_SEQ = 6,
+    VT_PAYLOAD = 8,
+    VT_LAST = 10
+  };
+  uint32_t id() const {
+    return GetField<uint32_t>(VT_ID, 0);
+  }
+  bool mutate_id(uint32_t _id) {
+    return SetField<uint32_t>(VT_ID, _id, 0);
+  }
+  uint32_t seq() const {
+    return GetField<uint32_t>(VT_SEQ, 0);
+  }
+  bool mutate_seq(uint32_t _seq) {
+    return SetField<uint32_t>(VT_SEQ, _seq, 0);
+  }
+  const flatbuffers::Vector<uint8_t> *payload() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_PAYLOAD);
+  }
+  flatbuffers::Vector<uint8_t> *mutable_payload() {
+    return GetPointer<flatbuffers::Vector<uint8_t> *>(VT_PAYLOAD);
+  }
+  bool last() const {
+    return GetField<uint8_t>(VT_LAST, 0) != 0;
+  }
+  bool mutate_last(bool _last) {
+    return SetField<uint8_t>(VT_LAST, static_cast<uint8_t>(_last), 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_ID) &&
+           VerifyField<uint32_t>(verifier, VT_SEQ) &&
+           VerifyOffset(verifier, VT_PAYLOAD) &&
+           verifier.VerifyVector(payload()) &&
+           VerifyField<uint8_t>(verifier, VT_LAST) &&
+           verifier.EndTable();
+  }
+};
+
+struct RequestChunkBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_id(uint32_t id) {
+    fbb_.AddElement<uint32_t>(RequestChunk::VT_ID, id, 0);
+  }
+  void add_seq(uint32_t seq) {
+    fbb_.AddElement<uint32_t>(RequestChunk::VT_SEQ, seq, 0);
+  }
+  void add_payload(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> payload) {
+    fbb_.AddOffset(RequestChunk::VT_PAYLOAD, payload);
+  }
+  void add_last(bool last) {
+    fbb_.AddElement<uint8_t>(RequestChunk::VT_LAST, static_cast<uint8_t>(last), 0);
+  }
+  explicit RequestChunkBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  RequestChunkBuilder &operator=(const RequestChunkBuilder &);
+  flatbuffers::Offset<RequestChunk> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<RequestChunk>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<RequestChunk> CreateRequestChunk(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t id = 0,
+    uint32_t seq = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> payload = 0,
+    bool last = false) {
+  RequestChunkBuilder builder_(_fbb);
+  builder_.add_payload(payload);
+  builder_.add_seq(seq);
+  builder_.add_id(id);
+  builder_.add_last(last);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<RequestChunk> CreateRequestChunkDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t id = 0,
+    uint32_t seq = 0,
+    const std::vector<uint8_t> *payload = nullptr,
+    bool last = false) {
+  auto payload__ = payload ? _fbb.CreateVector<uint8_t>(*payload) : 0;
+  return WsGw::proto::Service::Receive::CreateRequestChunk(
+      _fbb,
+      id,
+      seq,
+      payload__,
+      last);
+}
+
 }  // namespace Receive
 
 namespace Send {
@@ -780,6 +1842,22 @@ inline bool VerifySend(flatbuffers::Verifier &verifier, const void *obj, Send ty
       auto ptr = reinterpret_cast<const Broadcast *>(obj);
       return verifier.VerifyTable(ptr);
     }
+    case Send_BroadcastBatch: {
+      auto ptr = reinterpret_cast<const BroadcastBatch *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Send_BindKey: {
+      auto ptr = reinterpret_cast<const BindKey *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Send_ResponseChunk: {
+      auto ptr = reinterpret_cast<const ResponseChunk *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Send_UploadCredit: {
+      auto ptr = reinterpret_cast<const UploadCredit *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
     default: return false;
   }
 }
@@ -813,6 +1891,18 @@ inline bool VerifyReceive(flatbuffers::Verifier &verifier, const void *obj, Rece
       auto ptr = reinterpret_cast<const CancelRequest *>(obj);
       return verifier.VerifyTable(ptr);
     }
+    case Receive_SubscriberChange: {
+      auto ptr = reinterpret_cast<const SubscriberChange *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Receive_StreamCredit: {
+      auto ptr = reinterpret_cast<const StreamCredit *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Receive_RequestChunk: {
+      auto ptr = reinterpret_cast<const RequestChunk *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
     default: return false;
   }
 }
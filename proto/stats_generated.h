@@ -0,0 +1,293 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+
+#ifndef FLATBUFFERS_GENERATED_STATS_WSGW_PROTO_STATS_H_
+#define FLATBUFFERS_GENERATED_STATS_WSGW_PROTO_STATS_H_
+
+#include "flatbuffers/flatbuffers.h"
+
+namespace WsGw {
+namespace proto {
+namespace Stats {
+
+struct KeyCounter;
+
+struct ServiceStats;
+
+struct KeyCounter FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_KEY = 4,
+    VT_COUNT = 6
+  };
+  const flatbuffers::String *key() const {
+    return GetPointer<const flatbuffers::String *>(VT_KEY);
+  }
+  flatbuffers::String *mutable_key() {
+    return GetPointer<flatbuffers::String *>(VT_KEY);
+  }
+  uint64_t count() const {
+    return GetField<uint64_t>(VT_COUNT, 0);
+  }
+  bool mutate_count(uint64_t _count) {
+    return SetField<uint64_t>(VT_COUNT, _count, 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_KEY) &&
+           verifier.VerifyString(key()) &&
+           VerifyField<uint64_t>(verifier, VT_COUNT) &&
+           verifier.EndTable();
+  }
+};
+
+struct KeyCounterBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_key(flatbuffers::Offset<flatbuffers::String> key) {
+    fbb_.AddOffset(KeyCounter::VT_KEY, key);
+  }
+  void add_count(uint64_t count) {
+    fbb_.AddElement<uint64_t>(KeyCounter::VT_COUNT, count, 0);
+  }
+  explicit KeyCounterBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  KeyCounterBuilder &operator=(const KeyCounterBuilder &);
+  flatbuffers::Offset<KeyCounter> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<KeyCounter>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<KeyCounter> CreateKeyCounter(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> key = 0,
+    uint64_t count = 0) {
+  KeyCounterBuilder builder_(_fbb);
+  builder_.add_count(count);
+  builder_.add_key(key);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<KeyCounter> CreateKeyCounterDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *key = nullptr,
+    uint64_t count = 0) {
+  auto key__ = key ? _fbb.CreateString(key) : 0;
+  return WsGw::proto::Stats::CreateKeyCounter(
+      _fbb,
+      key__,
+      count);
+}
+
+struct ServiceStats FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_FRAMES_IN = 4,
+    VT_FRAMES_OUT = 6,
+    VT_BYTES_IN = 8,
+    VT_BYTES_OUT = 10,
+    VT_VERIFY_FAILURES = 12,
+    VT_INFLIGHT = 14,
+    VT_SEND_QUEUE = 16,
+    VT_RECONNECTS = 18,
+    VT_BROADCASTS = 20,
+    VT_RTT_US = 22,
+    VT_RTT_JITTER_US = 24
+  };
+  uint64_t frames_in() const {
+    return GetField<uint64_t>(VT_FRAMES_IN, 0);
+  }
+  bool mutate_frames_in(uint64_t _frames_in) {
+    return SetField<uint64_t>(VT_FRAMES_IN, _frames_in, 0);
+  }
+  uint64_t frames_out() const {
+    return GetField<uint64_t>(VT_FRAMES_OUT, 0);
+  }
+  bool mutate_frames_out(uint64_t _frames_out) {
+    return SetField<uint64_t>(VT_FRAMES_OUT, _frames_out, 0);
+  }
+  uint64_t bytes_in() const {
+    return GetField<uint64_t>(VT_BYTES_IN, 0);
+  }
+  bool mutate_bytes_in(uint64_t _bytes_in) {
+    return SetField<uint64_t>(VT_BYTES_IN, _bytes_in, 0);
+  }
+  uint64_t bytes_out() const {
+    return GetField<uint64_t>(VT_BYTES_OUT, 0);
+  }
+  bool mutate_bytes_out(uint64_t _bytes_out) {
+    return SetField<uint64_t>(VT_BYTES_OUT, _bytes_out, 0);
+  }
+  uint64_t verify_failures() const {
+    return GetField<uint64_t>(VT_VERIFY_FAILURES, 0);
+  }
+  bool mutate_verify_failures(uint64_t _verify_failures) {
+    return SetField<uint64_t>(VT_VERIFY_FAILURES, _verify_failures, 0);
+  }
+  int64_t inflight() const {
+    return GetField<int64_t>(VT_INFLIGHT, 0);
+  }
+  bool mutate_inflight(int64_t _inflight) {
+    return SetField<int64_t>(VT_INFLIGHT, _inflight, 0);
+  }
+  uint64_t send_queue() const {
+    return GetField<uint64_t>(VT_SEND_QUEUE, 0);
+  }
+  bool mutate_send_queue(uint64_t _send_queue) {
+    return SetField<uint64_t>(VT_SEND_QUEUE, _send_queue, 0);
+  }
+  uint64_t reconnects() const {
+    return GetField<uint64_t>(VT_RECONNECTS, 0);
+  }
+  bool mutate_reconnects(uint64_t _reconnects) {
+    return SetField<uint64_t>(VT_RECONNECTS, _reconnects, 0);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<KeyCounter>> *broadcasts() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<KeyCounter>> *>(VT_BROADCASTS);
+  }
+  flatbuffers::Vector<flatbuffers::Offset<KeyCounter>> *mutable_broadcasts() {
+    return GetPointer<flatbuffers::Vector<flatbuffers::Offset<KeyCounter>> *>(VT_BROADCASTS);
+  }
+  uint64_t rtt_us() const {
+    return GetField<uint64_t>(VT_RTT_US, 0);
+  }
+  bool mutate_rtt_us(uint64_t _rtt_us) {
+    return SetField<uint64_t>(VT_RTT_US, _rtt_us, 0);
+  }
+  uint64_t rtt_jitter_us() const {
+    return GetField<uint64_t>(VT_RTT_JITTER_US, 0);
+  }
+  bool mutate_rtt_jitter_us(uint64_t _rtt_jitter_us) {
+    return SetField<uint64_t>(VT_RTT_JITTER_US, _rtt_jitter_us, 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint64_t>(verifier, VT_FRAMES_IN) &&
+           VerifyField<uint64_t>(verifier, VT_FRAMES_OUT) &&
+           VerifyField<uint64_t>(verifier, VT_BYTES_IN) &&
+           VerifyField<uint64_t>(verifier, VT_BYTES_OUT) &&
+           VerifyField<uint64_t>(verifier, VT_VERIFY_FAILURES) &&
+           VerifyField<int64_t>(verifier, VT_INFLIGHT) &&
+           VerifyField<uint64_t>(verifier, VT_SEND_QUEUE) &&
+           VerifyField<uint64_t>(verifier, VT_RECONNECTS) &&
+           VerifyOffset(verifier, VT_BROADCASTS) &&
+           verifier.VerifyVector(broadcasts()) &&
+           verifier.VerifyVectorOfTables(broadcasts()) &&
+           VerifyField<uint64_t>(verifier, VT_RTT_US) &&
+           VerifyField<uint64_t>(verifier, VT_RTT_JITTER_US) &&
+           verifier.EndTable();
+  }
+};
+
+struct ServiceStatsBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_frames_in(uint64_t frames_in) {
+    fbb_.AddElement<uint64_t>(ServiceStats::VT_FRAMES_IN, frames_in, 0);
+  }
+  void add_frames_out(uint64_t frames_out) {
+    fbb_.AddElement<uint64_t>(ServiceStats::VT_FRAMES_OUT, frames_out, 0);
+  }
+  void add_bytes_in(uint64_t bytes_in) {
+    fbb_.AddElement<uint64_t>(ServiceStats::VT_BYTES_IN, bytes_in, 0);
+  }
+  void add_bytes_out(uint64_t bytes_out) {
+    fbb_.AddElement<uint64_t>(ServiceStats::VT_BYTES_OUT, bytes_out, 0);
+  }
+  void add_verify_failures(uint64_t verify_failures) {
+    fbb_.AddElement<uint64_t>(ServiceStats::VT_VERIFY_FAILURES, verify_failures, 0);
+  }
+  void add_inflight(int64_t inflight) {
+    fbb_.AddElement<int64_t>(ServiceStats::VT_INFLIGHT, inflight, 0);
+  }
+  void add_send_queue(uint64_t send_queue) {
+    fbb_.AddElement<uint64_t>(ServiceStats::VT_SEND_QUEUE, send_queue, 0);
+  }
+  void add_reconnects(uint64_t reconnects) {
+    fbb_.AddElement<uint64_t>(ServiceStats::VT_RECONNECTS, reconnects, 0);
+  }
+  void add_broadcasts(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<KeyCounter>>> broadcasts) {
+    fbb_.AddOffset(ServiceStats::VT_BROADCASTS, broadcasts);
+  }
+  void add_rtt_us(uint64_t rtt_us) {
+    fbb_.AddElement<uint64_t>(ServiceStats::VT_RTT_US, rtt_us, 0);
+  }
+  void add_rtt_jitter_us(uint64_t rtt_jitter_us) {
+    fbb_.AddElement<uint64_t>(ServiceStats::VT_RTT_JITTER_US, rtt_jitter_us, 0);
+  }
+  explicit ServiceStatsBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ServiceStatsBuilder &operator=(const ServiceStatsBuilder &);
+  flatbuffers::Offset<ServiceStats> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<ServiceStats>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<ServiceStats> CreateServiceStats(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint64_t frames_in = 0,
+    uint64_t frames_out = 0,
+    uint64_t bytes_in = 0,
+    uint64_t bytes_out = 0,
+    uint64_t verify_failures = 0,
+    int64_t inflight = 0,
+    uint64_t send_queue = 0,
+    uint64_t reconnects = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<KeyCounter>>> broadcasts = 0,
+    uint64_t rtt_us = 0,
+    uint64_t rtt_jitter_us = 0) {
+  ServiceStatsBuilder builder_(_fbb);
+  builder_.add_rtt_jitter_us(rtt_jitter_us);
+  builder_.add_rtt_us(rtt_us);
+  builder_.add_reconnects(reconnects);
+  builder_.add_send_queue(send_queue);
+  builder_.add_inflight(inflight);
+  builder_.add_verify_failures(verify_failures);
+  builder_.add_bytes_out(bytes_out);
+  builder_.add_bytes_in(bytes_in);
+  builder_.add_frames_out(frames_out);
+  builder_.add_frames_in(frames_in);
+  builder_.add_broadcasts(broadcasts);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<ServiceStats> CreateServiceStatsDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint64_t frames_in = 0,
+    uint64_t frames_out = 0,
+    uint64_t bytes_in = 0,
+    uint64_t bytes_out = 0,
+    uint64_t verify_failures = 0,
+    int64_t inflight = 0,
+    uint64_t send_queue = 0,
+    uint64_t reconnects = 0,
+    const std::vector<flatbuffers::Offset<KeyCounter>> *broadcasts = nullptr,
+    uint64_t rtt_us = 0,
+    uint64_t rtt_jitter_us = 0) {
+  auto broadcasts__ = broadcasts ? _fbb.CreateVector<flatbuffers::Offset<KeyCounter>>(*broadcasts) : 0;
+  return WsGw::proto::Stats::CreateServiceStats(
+      _fbb,
+      frames_in,
+      frames_out,
+      bytes_in,
+      bytes_out,
+      verify_failures,
+      inflight,
+      send_queue,
+      reconnects,
+      broadcasts__,
+      rtt_us,
+      rtt_jitter_us);
+}
+
+}  // namespace Stats
+}  // namespace proto
+}  // namespace WsGw
+
+#endif  // FLATBUFFERS_GENERATED_STATS_WSGW_PROTO_STATS_H_
@@ -0,0 +1,60 @@
+#include <system_error>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../include/ws-gw.h"
+
+namespace WsGw {
+
+#ifdef _WIN32
+Buffer Buffer::MapFile(std::string const &path) {
+  auto file = CreateFileA(
+      path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) throw std::system_error{(int) GetLastError(), std::system_category(), path};
+  LARGE_INTEGER size{};
+  HANDLE mapping = nullptr;
+  void *view     = nullptr;
+  DWORD err      = 0;
+  if (!GetFileSizeEx(file, &size))
+    err = GetLastError();
+  else if (size.QuadPart && !(mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)))
+    err = GetLastError();
+  else if (mapping && !(view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)))
+    err = GetLastError();
+  if (mapping) CloseHandle(mapping);
+  CloseHandle(file);
+  if (err) throw std::system_error{(int) err, std::system_category(), path};
+  if (!view) return {};
+  return {(uint8_t const *) view, (size_t) size.QuadPart, [](uint8_t const *data, size_t) {
+            UnmapViewOfFile(data);
+          }};
+}
+#else
+Buffer Buffer::MapFile(std::string const &path) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) throw std::system_error{errno, std::generic_category(), path};
+  struct stat st {};
+  void *addr = nullptr;
+  int err    = 0;
+  if (fstat(fd, &st) != 0)
+    err = errno;
+  else if (st.st_size && (addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)) == MAP_FAILED)
+    err = errno;
+  close(fd);
+  if (err) throw std::system_error{err, std::generic_category(), path};
+  if (!addr) return {};
+  return {(uint8_t const *) addr, (size_t) st.st_size, [](uint8_t const *data, size_t size) {
+            munmap((void *) data, size);
+          }};
+}
+#endif
+
+} // namespace WsGw
@@ -1,8 +1,15 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
 #include <exception>
 #include <functional>
+#include <future>
+#include <list>
 #include <mutex>
 #include <stdexcept>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include <flatbuffers/flatbuffers.h>
 
@@ -12,6 +19,7 @@
 #include <websocketpp/logger/levels.hpp>
 
 #include "../proto/service_generated.h"
+#include "../proto/stats_generated.h"
 
 #include "../include/ws-gw.h"
 
@@ -20,47 +28,798 @@ using namespace std::placeholders;
 namespace opcode       = websocketpp::frame::opcode;
 namespace close_status = websocketpp::close::status;
 
+enum Feature : uint32_t {
+  FeatureSubscriberNotify = 1,
+  FeatureBroadcastBatch   = 2,
+  FeatureMethodIds        = 4,
+  FeatureStreaming        = 8,
+  FeatureUploads          = 16,
+  FeatureMultiplex        = 32,
+};
+
+constexpr uint32_t defaultStreamWindow = 8;
+constexpr uint32_t uploadWindow        = 8;
+
+// Method ids index a dense table, so ids assigned by the gateway must stay below this.
+constexpr uint32_t maxMethodId = 1 << 16;
+
+struct Service::KeyState : std::enable_shared_from_this<KeyState> {
+  std::string const key;
+  uint32_t const id, service;
+  std::string encoded; // key as serialized by CreateString: length, bytes and terminator
+  std::atomic_uint64_t broadcasts{};
+  std::atomic_bool subscribed{false};
+  std::atomic_bool bound{false}; // id declared with BindKey on the current connection
+
+  std::mutex mtx;
+  std::chrono::microseconds interval{0};
+  std::optional<std::string> pending;
+  bool armed = false;
+  Tracer::clock::time_point flushed;
+
+  KeyState(std::string key, uint32_t id, uint32_t service) : key(std::move(key)), id(id), service(service) {
+    flatbuffers::FlatBufferBuilder buf{this->key.size() + 16};
+    buf.CreateString(this->key);
+    encoded.assign((char const *) buf.GetCurrentBufferPointer(), sizeof(flatbuffers::uoffset_t) + this->key.size() + 1);
+#ifndef NDEBUG
+    // PushKey has to stay interchangeable with CreateString whatever the builder already holds.
+    for (uint8_t pad = 0; pad < sizeof(flatbuffers::uoffset_t); pad++) {
+      flatbuffers::FlatBufferBuilder created{64}, pushed{64};
+      for (uint8_t i = 0; i < pad; i++) created.PushElement(i), pushed.PushElement(i);
+      auto expected = created.CreateString(this->key);
+      auto actual   = PushKey(pushed);
+      assert(expected.o == actual.o && created.GetSize() == pushed.GetSize());
+      assert(!std::memcmp(created.GetCurrentBufferPointer(), pushed.GetCurrentBufferPointer(), created.GetSize()));
+    }
+#endif
+  }
+
+  // Same bytes and alignment CreateString would produce, without re-serializing the key.
+  flatbuffers::Offset<flatbuffers::String> PushKey(flatbuffers::FlatBufferBuilder &buf) const {
+    buf.PreAlign<flatbuffers::uoffset_t>(key.size() + 1);
+    buf.PushBytes((uint8_t const *) encoded.data(), encoded.size());
+    return flatbuffers::Offset<flatbuffers::String>{buf.GetSize()};
+  }
+
+  flatbuffers::Offset<proto::Service::Send::Broadcast>
+  Encode(flatbuffers::FlatBufferBuilder &buf, BufferView data, bool bound) const {
+    auto skey    = bound ? flatbuffers::Offset<flatbuffers::String>{} : PushKey(buf);
+    auto payload = buf.CreateVector(data.data(), data.size());
+    return proto::Service::Send::CreateBroadcast(buf, skey, payload, bound ? id : 0, bound ? 0 : service);
+  }
+};
+
+struct Service::Gate {
+  HandlerLimits limits;
+  std::atomic_uint32_t running{};
+  double tokens;
+  Tracer::clock::time_point refilled = Tracer::clock::now();
+
+  Gate(HandlerLimits limits) : limits(limits), tokens(Capacity()) {}
+
+  double Capacity() const { return std::max(limits.burst, 1.0); }
+};
+
+struct Service::Cache {
+  struct Item {
+    size_t hash;
+    std::string request, packet;
+    Tracer::clock::time_point expires;
+
+    size_t Size() const { return request.size() + packet.size(); }
+  };
+
+  CacheOptions const options;
+  std::mutex mtx;
+  std::list<Item> items; // most recently used first
+  std::unordered_map<size_t, std::list<Item>::iterator> index;
+  size_t bytes = 0;
+
+  Cache(CacheOptions options) : options(options) {}
+
+  std::optional<std::string> Find(size_t hash, std::string_view request) {
+    std::lock_guard lk{mtx};
+    auto it = index.find(hash);
+    if (it == index.end() || it->second->request != request) return std::nullopt;
+    auto item = it->second;
+    if (options.ttl.count() && item->expires <= Tracer::clock::now()) {
+      Erase(item);
+      return std::nullopt;
+    }
+    items.splice(items.begin(), items, item);
+    return item->packet;
+  }
+
+  // A colliding entry is replaced, so each hash maps to at most one request.
+  void Insert(size_t hash, std::string_view request, std::string packet) {
+    Item item{hash, std::string{request}, std::move(packet), Tracer::clock::now() + options.ttl};
+    if (item.Size() > options.maxBytes) return;
+    std::lock_guard lk{mtx};
+    if (auto it = index.find(hash); it != index.end()) Erase(it->second);
+    bytes += item.Size();
+    items.push_front(std::move(item));
+    index[hash] = items.begin();
+    while (bytes > options.maxBytes) Erase(std::prev(items.end()));
+  }
+
+  void Invalidate(size_t hash, std::string_view request) {
+    std::lock_guard lk{mtx};
+    if (auto it = index.find(hash); it != index.end() && it->second->request == request) Erase(it->second);
+  }
+
+  void Clear() {
+    std::lock_guard lk{mtx};
+    items.clear();
+    index.clear();
+    bytes = 0;
+  }
+
+private:
+  void Erase(std::list<Item>::iterator item) {
+    bytes -= item->Size();
+    index.erase(item->hash);
+    items.erase(item);
+  }
+};
+
+// Requests waiting on a running handler call, keyed by payload; the first one is the one that called the handler.
+// Waiters keep the generation of the connection they arrived on, since a call can outlive it.
+struct Service::Flights {
+  struct Waiter {
+    uint32_t id, generation;
+  };
+
+  std::mutex mtx;
+  std::map<std::string, std::vector<Waiter>, std::less<>> running;
+
+  // Returns false when no call is running for request, in which case id starts a new one.
+  bool Join(std::string_view request, Waiter waiter) {
+    std::lock_guard lk{mtx};
+    auto it = running.find(request);
+    if (it == running.end()) {
+      running.emplace(std::string{request}, std::vector<Waiter>{waiter});
+      return false;
+    }
+    it->second.push_back(waiter);
+    return true;
+  }
+
+  std::vector<Waiter> Finish(std::string_view request) {
+    std::lock_guard lk{mtx};
+    auto it  = running.find(request);
+    auto ids = std::move(it->second);
+    running.erase(it);
+    return ids;
+  }
+};
+
+namespace {
+std::string EncodeRejection(char const *message) {
+  flatbuffers::FlatBufferBuilder buf{64};
+  buf.ForceDefaults(true);
+  auto exinfo = proto::CreateExceptionInfoDirect(buf, message);
+  auto exobj  = proto::Service::Send::CreateException(buf, 0, exinfo);
+  buf.Finish(proto::Service::Send::CreateSendPacket(buf, proto::Service::Send::Send_Exception, exobj.Union()));
+  return {(char const *) buf.GetBufferPointer(), buf.GetSize()};
+}
+
+std::string const overloaded = EncodeRejection("Service overloaded");
+std::string const busy       = EncodeRejection("Too many concurrent requests");
+std::string const throttled  = EncodeRejection("Rate limit exceeded");
+
+void EncodeResponse(flatbuffers::FlatBufferBuilder &buf, uint32_t id, BufferView view) {
+  auto payload = buf.CreateVector(view.data(), view.size());
+  auto respobj = proto::Service::Send::CreateResponse(buf, id, payload);
+  buf.Finish(proto::Service::Send::CreateSendPacket(buf, proto::Service::Send::Send_Response, respobj.Union()));
+}
+
+void EncodeException(flatbuffers::FlatBufferBuilder &buf, uint32_t id, std::string_view message) {
+  auto exinfo = proto::CreateExceptionInfo(buf, buf.CreateString(message.data(), message.size()));
+  auto exobj  = proto::Service::Send::CreateException(buf, id, exinfo);
+  buf.Finish(proto::Service::Send::CreateSendPacket(buf, proto::Service::Send::Send_Exception, exobj.Union()));
+}
+
+// Wraps the table at root, the only thing built into buf so far, as a nested flatbuffer in place: a root offset and
+// a vector length are pushed in front of it, and the result becomes the Response payload without being copied.
+void EncodeNestedResponse(flatbuffers::FlatBufferBuilder &buf, uint32_t id, flatbuffers::uoffset_t root) {
+  buf.PreAlign(sizeof(flatbuffers::uoffset_t), sizeof(flatbuffers::largest_scalar_t));
+  buf.PushElement(buf.ReferTo(root));
+  flatbuffers::Offset<flatbuffers::Vector<uint8_t>> payload{buf.PushElement(buf.GetSize())};
+  auto respobj = proto::Service::Send::CreateResponse(buf, id, payload);
+  buf.Finish(proto::Service::Send::CreateSendPacket(buf, proto::Service::Send::Send_Response, respobj.Union()));
+#ifndef NDEBUG
+  // The payload has to read back as a standalone buffer rooted at a table; its schema is only known to the handler.
+  struct AnyTable : flatbuffers::Table {
+    bool Verify(flatbuffers::Verifier &verifier) const { return VerifyTableStart(verifier) && verifier.EndTable(); }
+  };
+  flatbuffers::Verifier verifier{buf.GetBufferPointer(), buf.GetSize()};
+  assert(verifier.VerifyBuffer<proto::Service::Send::SendPacket>(nullptr));
+  auto packet = flatbuffers::GetRoot<proto::Service::Send::SendPacket>(buf.GetBufferPointer());
+  assert(verifier.VerifyNestedFlatBuffer<AnyTable>(packet->packet_as_Response()->payload(), nullptr));
+#endif
+}
+
+// Rewrites the id of a pre-encoded packet; the id field must have been written with ForceDefaults.
+template <typename T> void PatchId(std::string &packet, uint32_t id) {
+  auto root = flatbuffers::GetMutableRoot<proto::Service::Send::SendPacket>(packet.data());
+  static_cast<T *>(root->mutable_packet())->mutate_id(id);
+}
+} // namespace
+
+Service::StatsSlot &Service::Slot() {
+  static thread_local size_t index = std::hash<std::thread::id>{}(std::this_thread::get_id());
+  return slots[index % slots.size()];
+}
+
+Service::KeyState &Service::Key(std::string_view key, uint32_t service) {
+  {
+    std::shared_lock lk{keymtx};
+    if (auto it = keys.find(std::pair{service, key}); it != keys.end()) return *it->second;
+  }
+  std::unique_lock lk{keymtx};
+  auto &state = keys[{service, std::string{key}}];
+  if (!state) state = std::make_shared<KeyState>(std::string{key}, ++lastKeyId, service);
+  return *state;
+}
+
+void Service::Register(std::string const &name, Handler async, ExpectedHandler sync, uint32_t service) {
+  auto &entry = Table(service)[name];
+  if (!entry.Empty()) return;
+  entry.async = std::move(async);
+  entry.sync  = std::move(sync);
+}
+
+void Service::RegisterTyped(std::string const &name, TypedHandler handler) {
+  auto &entry = mapped[name];
+  if (entry.Empty()) entry.typed = std::move(handler);
+}
+
+void Service::RegisterStreamHandler(std::string const &name, StreamHandler handler) {
+  auto &entry = mapped[name];
+  if (entry.Empty()) entry.stream = std::move(handler);
+}
+
+bool StreamWriter::Write(BufferView chunk) {
+  std::lock_guard lk{mtx};
+  if (done || cancelled) return false;
+  if (!chunked) {
+    collected.append((char const *) chunk.data(), chunk.size());
+    return true;
+  }
+  if (!credits) return false;
+  credits--;
+  srv->SendChunk(id, seq++, chunk, false, generation);
+  return true;
+}
+
+void StreamWriter::End(BufferView chunk) {
+  std::lock_guard lk{mtx};
+  if (done) return;
+  Finish();
+  if (cancelled) return srv->Complete(id);
+  if (chunked) {
+    srv->Complete(id);
+    srv->SendChunk(id, seq++, chunk, true, generation);
+  } else {
+    collected.append((char const *) chunk.data(), chunk.size());
+    srv->SendResponse(id, collected, generation);
+  }
+}
+
+void StreamWriter::Fail(std::string_view message) {
+  std::lock_guard lk{mtx};
+  if (done) return;
+  Finish();
+  if (cancelled)
+    srv->Complete(id);
+  else
+    srv->SendException(id, message, generation);
+}
+
+void StreamWriter::Finish() {
+  done = true;
+  srv->Release(gate);
+  if (chunked) {
+    std::lock_guard lk{srv->streammtx};
+    srv->streams.erase(id);
+  }
+}
+
+StreamWriter::~StreamWriter() {
+  try {
+    Fail("Stream abandoned");
+  } catch (...) {
+  }
+}
+
+void StreamWriter::Grant(uint32_t credits) {
+  std::function<void()> fn;
+  {
+    std::lock_guard lk{mtx};
+    this->credits += credits;
+    fn = onWritable;
+  }
+  if (fn) fn();
+}
+
+void StreamWriter::Cancel() {
+  std::function<void()> fn;
+  {
+    std::lock_guard lk{mtx};
+    cancelled = true;
+    fn        = onWritable;
+  }
+  if (fn) fn();
+}
+
+void StreamWriter::OnWritable(std::function<void()> fn) {
+  std::lock_guard lk{mtx};
+  onWritable = std::move(fn);
+}
+
+bool StreamWriter::Cancelled() {
+  std::lock_guard lk{mtx};
+  return cancelled;
+}
+
+void Service::RegisterUploadHandler(std::string const &name, UploadHandler handler) {
+  auto &entry = mapped[name];
+  if (entry.Empty()) entry.upload = std::move(handler);
+}
+
+void StreamReader::Push(uint32_t seq, Buffer chunk, bool last) {
+  ReadCallback fn;
+  {
+    std::lock_guard lk{mtx};
+    if (ep || received) return;
+    if (seq != nextSeq++ || queued.size() > uploadWindow) {
+      ep = std::make_exception_ptr(std::runtime_error{"Upload out of order or over its window"});
+    } else {
+      received = last;
+      queued.push_back(std::move(chunk));
+    }
+    fn.swap(waiting);
+  }
+  if (fn) Read(std::move(fn));
+}
+
+void StreamReader::Abort(std::exception_ptr ep) {
+  ReadCallback fn;
+  {
+    std::lock_guard lk{mtx};
+    if (this->ep || received) return;
+    this->ep = ep;
+    fn.swap(waiting);
+  }
+  if (fn) Read(std::move(fn));
+}
+
+void StreamReader::Read(ReadCallback fn) {
+  std::unique_lock lk{mtx};
+  if (ep) {
+    lk.unlock();
+    return fn(ep, {}, true);
+  }
+  if (queued.empty()) {
+    if (!delivered) {
+      waiting = std::move(fn);
+      return;
+    }
+    lk.unlock();
+    return fn(nullptr, {}, true);
+  }
+  auto chunk = std::move(queued.front());
+  queued.pop_front();
+  auto last = delivered = received && queued.empty();
+  // The first part came with the Request itself and used no credit.
+  uint32_t credits = 0;
+  if (readSeq++ && !received && ++consumed >= std::max(uploadWindow / 2, 1u)) std::swap(credits, consumed);
+  lk.unlock();
+  if (credits) {
+    flatbuffers::FlatBufferBuilder buf{64};
+    auto creditobj = proto::Service::Send::CreateUploadCredit(buf, id, credits);
+    buf.Finish(
+        proto::Service::Send::CreateSendPacket(buf, proto::Service::Send::Send_UploadCredit, creditobj.Union()));
+    srv->Send(buf.GetBufferPointer(), buf.GetSize(), generation);
+  }
+  fn(nullptr, std::move(chunk), last);
+}
+
+void Service::RegisterFlexHandler(std::string const &name, FlexHandler handler) {
+  Register(name, {}, [this, handler{std::move(handler)}](BufferView const &view) -> Expected<Buffer> {
+#if FLATBUFFERS_VERSION_MAJOR >= 2
+    if (!flexbuffers::VerifyBuffer(view.data(), view.size())) return Error{"Invalid FlexBuffer payload"};
+#else
+    if (view.size() < 3) return Error{"Invalid FlexBuffer payload"};
+#endif
+    auto builder = flexPool.Acquire();
+    handler(FlexRoot(view), *builder);
+    builder->Finish();
+    auto &bytes = builder->GetBuffer();
+    return Buffer{bytes.data(), bytes.size(), [pool = &flexPool, raw = builder.release()](auto, size_t) {
+                    pool->Release(raw);
+                  }};
+  });
+}
+
+FlexBuilderPool::Handle FlexBuilderPool::Acquire() {
+  std::unique_ptr<flexbuffers::Builder> builder;
+  {
+    std::lock_guard lk{mtx};
+    if (!free.empty()) {
+      builder = std::move(free.back());
+      free.pop_back();
+    }
+  }
+  if (!builder) builder = std::make_unique<flexbuffers::Builder>();
+  return Handle{builder.release(), Deleter{this}};
+}
+
+void FlexBuilderPool::Release(flexbuffers::Builder *builder) noexcept {
+  std::unique_ptr<flexbuffers::Builder> owned{builder};
+  owned->Clear();
+  std::lock_guard lk{mtx};
+  if (free.size() < 16) free.push_back(std::move(owned));
+}
+
+void Service::EnableCache(std::string const &name, CacheOptions options) {
+  mapped[name].cache = std::make_shared<Cache>(options);
+}
+
+void Service::InvalidateCache(std::string const &name) {
+  if (auto it = mapped.find(name); it != mapped.end() && it->second.cache) it->second.cache->Clear();
+}
+
+void Service::InvalidateCache(std::string const &name, BufferView payload) {
+  if (auto it = mapped.find(name); it != mapped.end() && it->second.cache) {
+    std::string_view request = payload;
+    it->second.cache->Invalidate(std::hash<std::string_view>{}(request), request);
+  }
+}
+
+void Service::EnableCoalescing(std::string const &name) { mapped[name].flights = std::make_shared<Flights>(); }
+
+void Service::SetLimits(std::string const &name, HandlerLimits limits) {
+  mapped[name].gate = std::make_shared<Gate>(limits);
+}
+
+// Only called from OnMessage, so the checks cannot race with each other; completions only ever lower the counts.
+std::string const *Service::Admit(Gate *gate) {
+  if (maxInflight && running.load(std::memory_order_relaxed) >= maxInflight) return &overloaded;
+  if (gate) {
+    auto &limits = gate->limits;
+    if (limits.maxConcurrent && gate->running.load(std::memory_order_relaxed) >= limits.maxConcurrent) return &busy;
+    if (limits.rate > 0) {
+      auto now       = Tracer::clock::now();
+      auto elapsed   = std::chrono::duration<double>(now - gate->refilled).count();
+      gate->tokens   = std::min(gate->Capacity(), gate->tokens + elapsed * limits.rate);
+      gate->refilled = now;
+      if (gate->tokens < 1) return &throttled;
+      gate->tokens -= 1;
+    }
+    gate->running.fetch_add(1, std::memory_order_relaxed);
+  }
+  running.fetch_add(1, std::memory_order_relaxed);
+  return nullptr;
+}
+
+void Service::Release(Gate *gate) {
+  running.fetch_sub(1, std::memory_order_relaxed);
+  if (gate) gate->running.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// A reply passes the generation of the connection its request arrived on and is dropped once that connection is
+// gone, as is anything sent while reconnecting; the shared lock keeps Drop from swapping the connection mid-send.
+void Service::Send(uint8_t const *data, size_t size, std::optional<uint32_t> gen) {
+  {
+    std::shared_lock lk{conmtx};
+    if ((gen && *gen != generation) || conhdr.expired()) return;
+    ws.send(conhdr, data, size, opcode::BINARY);
+  }
+  auto &slot = Slot();
+  slot.framesOut.fetch_add(1, std::memory_order_relaxed);
+  slot.bytesOut.fetch_add(size, std::memory_order_relaxed);
+  if (backpressure.highWatermark && !congested && SendQueue() > backpressure.highWatermark) Congest();
+}
+
+void Service::Complete(uint32_t id) {
+  Slot().inflight.fetch_sub(1, std::memory_order_relaxed);
+  if (tracer) {
+    auto now = Tracer::clock::now();
+    tracer->Stop(id, TraceStage::Handler, now);
+    tracer->Start(id, TraceStage::Encode, now);
+  }
+}
+
+websocketpp::connection_hdl Service::Connection() {
+  std::shared_lock lk{conmtx};
+  return conhdr;
+}
+
+void Service::Transmit(uint32_t id, BufferView packet, uint32_t gen) {
+  if (tracer) {
+    auto now = Tracer::clock::now();
+    tracer->Stop(id, TraceStage::Encode, now);
+    tracer->Start(id, TraceStage::Send, now);
+  }
+  Send(packet.data(), packet.size(), gen);
+  if (tracer) tracer->Stop(id, TraceStage::Send, Tracer::clock::now());
+}
+
+void Service::SendResponse(uint32_t id, BufferView view, uint32_t gen) {
+  Complete(id);
+  flatbuffers::FlatBufferBuilder buf{256};
+  EncodeResponse(buf, id, view);
+  Transmit(id, buf, gen);
+}
+
+void Service::SendException(uint32_t id, std::string_view message, uint32_t gen) {
+  Complete(id);
+  flatbuffers::FlatBufferBuilder buf{256};
+  EncodeException(buf, id, message);
+  Transmit(id, buf, gen);
+}
+
+void Service::SendChunk(uint32_t id, uint32_t seq, BufferView chunk, bool last, uint32_t gen) {
+  flatbuffers::FlatBufferBuilder buf{chunk.size() + 64};
+  auto payload  = buf.CreateVector(chunk.data(), chunk.size());
+  auto chunkobj = proto::Service::Send::CreateResponseChunk(buf, id, seq, payload, last);
+  buf.Finish(proto::Service::Send::CreateSendPacket(buf, proto::Service::Send::Send_ResponseChunk, chunkobj.Union()));
+  if (last)
+    Transmit(id, buf, gen);
+  else
+    Send(buf.GetBufferPointer(), buf.GetSize(), gen);
+}
+
+std::shared_ptr<StreamReader> Service::Upload(uint32_t id, bool erase) {
+  std::lock_guard lk{streammtx};
+  auto it = uploads.find(id);
+  if (it == uploads.end()) return nullptr;
+  auto reader = it->second;
+  if (erase) uploads.erase(it);
+  return reader;
+}
+
+std::shared_ptr<StreamWriter> Service::Stream(uint32_t id) {
+  std::lock_guard lk{streammtx};
+  auto it = streams.find(id);
+  return it == streams.end() ? nullptr : it->second.lock();
+}
+
 void Service::OnMessage(websocketpp::connection_hdl hdl, websocketpp::config::asio_client::message_type::ptr msg) {
   try {
+    if (hdl.owner_before(conhdr) || conhdr.owner_before(hdl)) return; // left over from a dropped connection
     if (msg->get_opcode() == opcode::TEXT) throw RemoteException{msg->get_payload()};
+    // Frames the socket had already read when reading stopped are held for Drain; past maxPaused, requests are
+    // answered as overloaded and everything else is handled at once.
+    auto shed = false;
+    if (flag == 2 && congested && backpressure.pauseRequests) {
+      if (paused.size() < backpressure.maxPaused) return paused.push_back(msg);
+      shed = true;
+    }
+
+    Tracer::clock::time_point read;
+    if (tracer) read = Tracer::clock::now();
+
+    auto &slot = Slot();
+    slot.framesIn.fetch_add(1, std::memory_order_relaxed);
+    slot.bytesIn.fetch_add(msg->get_payload().size(), std::memory_order_relaxed);
 
     flatbuffers::Verifier verifier{(uint8_t const *) msg->get_payload().c_str(), msg->get_payload().size()};
 
     if (flag == 1) {
       auto resp = flatbuffers::GetRoot<proto::Service::HandshakeResponse>(msg->get_payload().c_str());
-      if (!resp->Verify(verifier)) return;
+      if (!resp->Verify(verifier)) {
+        slot.verifyFailures.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
       if (resp->magic()->string_view() != "WS-GATEWAY OK") throw MagicError{"WS-GATEWAY OK", resp->magic()->c_str()};
-      flag = 2;
+      if (established) reconnects.fetch_add(1, std::memory_order_relaxed);
+      established = true;
+      features    = resp->features();
+      {
+        std::shared_lock lk{keymtx};
+        for (auto &[key, state] : keys) state->subscribed = state->bound = false;
+      }
+      streamWindow = resp->stream_window() ? resp->stream_window() : defaultStreamWindow;
+      methods.clear();
+      auto assign = [this](flatbuffers::Vector<uint32_t> const *ids, std::vector<HandlerEntry *> const &entries) {
+        for (size_t i = 0; ids && i < ids->size() && i < entries.size(); i++) {
+          auto method = ids->Get(i);
+          if (!method || method >= maxMethodId) continue;
+          if (methods.size() <= method) methods.resize(method + 1);
+          methods[method] = entries[i];
+        }
+      };
+      if (features & FeatureMethodIds) {
+        assign(resp->method_ids(), announced[0]);
+        if ((features & FeatureMultiplex) && resp->hosted())
+          for (size_t i = 0; i < resp->hosted()->size() && i + 1 < announced.size(); i++)
+            assign(resp->hosted()->Get(i)->method_ids(), announced[i + 1]);
+      }
+      flag        = 2;
       cv.notify_all();
+      if (connectTimer) connectTimer->cancel();
+      backoff      = {};
+      awaitingPong = false;
+      pinged       = Tracer::clock::now() - heartbeat.interval;
+      Heartbeat();
+      if (auto fn = std::exchange(onconnect, nullptr)) fn(nullptr);
     } else {
       auto recv = flatbuffers::GetRoot<proto::Service::Receive::ReceivePacket>(msg->get_payload().c_str());
-      if (!recv->Verify(verifier)) return;
+      if (!recv->Verify(verifier)) {
+        slot.verifyFailures.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      if (auto change = recv->packet_as_SubscriberChange(); change && change->key()) {
+        if (change->service() <= hosted.size())
+          Key(change->key()->string_view(), change->service()).subscribed = change->active();
+        return;
+      }
+      if (auto credit = recv->packet_as_StreamCredit()) {
+        if (auto writer = Stream(credit->id())) writer->Grant(credit->credits());
+        return;
+      }
+      if (auto chunk = recv->packet_as_RequestChunk()) {
+        auto reader = Upload(chunk->id(), chunk->last());
+        if (!reader) return;
+        Buffer part;
+        if (auto payload = chunk->payload()) part = Buffer{payload->data(), payload->size(), [msg](auto, size_t) {}};
+        reader->Push(chunk->seq(), std::move(part), chunk->last());
+        return;
+      }
+      if (auto cancel = recv->packet_as_CancelRequest()) {
+        if (auto writer = Stream(cancel->id())) writer->Cancel();
+        if (auto reader = Upload(cancel->id(), true))
+          reader->Abort(std::make_exception_ptr(std::runtime_error{"Request cancelled"}));
+        return;
+      }
       auto req = recv->packet_as_Request();
       if (req) {
-        auto id      = req->id();
-        auto key     = req->key()->str();
-        auto payload = req->payload();
-        auto it      = mapped.find(key);
-        auto handler = it == mapped.end() ? defaultHandler : it->second;
-        handler({payload->data(), payload->size()}, [id, this](std::exception_ptr ep, BufferView view) {
-          flatbuffers::FlatBufferBuilder buf{256};
-          flatbuffers::Offset<proto::Service::Send::SendPacket> packet;
-          if (ep) {
+        auto id             = req->id();
+        auto gen            = generation;
+        auto method         = req->method();
+        auto service        = req->service();
+        auto payload        = req->payload();
+        HandlerEntry *entry = nullptr;
+        if (method) {
+          if (method < methods.size()) entry = methods[method];
+        } else if (req->key() && service <= hosted.size()) {
+          auto key    = req->key()->string_view();
+          auto &table = Table(service);
+          if (auto index = !service && fixedFind ? fixedFind(key) : -1; index >= 0)
+            entry = fixed[index];
+          else if (auto it = table.find(key); it != table.end())
+            entry = &it->second;
+        }
+        auto gate    = entry ? entry->gate.get() : nullptr;
+        auto inlined = entry && entry->Inline();
+        auto cache   = inlined && !entry->typed ? entry->cache.get() : nullptr;
+        std::string_view request{(char const *) payload->data(), payload->size()};
+        size_t hash = 0;
+        if (cache) {
+          hash = std::hash<std::string_view>{}(request);
+          if (auto packet = cache->Find(hash, request)) {
+            PatchId<proto::Service::Send::Response>(*packet, id);
+            return Send((uint8_t const *) packet->data(), packet->size());
+          }
+        }
+        auto flights = entry && !inlined && !entry->stream && !entry->upload ? entry->flights.get() : nullptr;
+        auto joined  = !shed && flights && flights->Join(request, {id, gen});
+        if (auto rejection = shed ? &overloaded : joined ? nullptr : Admit(gate)) {
+          if (flights && !shed) flights->Finish(request);
+          std::string packet = *rejection;
+          PatchId<proto::Service::Send::Exception>(packet, id);
+          return Send((uint8_t const *) packet.data(), packet.size());
+        }
+        if (tracer) {
+          auto now = Tracer::clock::now();
+          tracer->Start(id, TraceStage::Verify, read);
+          tracer->Stop(id, TraceStage::Verify, now);
+          tracer->Start(id, TraceStage::Handler, now);
+        }
+        slot.inflight.fetch_add(1, std::memory_order_relaxed);
+        if (joined) return;
+        BufferView view{payload->data(), payload->size()};
+        if (entry && entry->upload) {
+          auto streamed = req->streamed() && (features & FeatureUploads);
+          std::shared_ptr<StreamReader> reader{new StreamReader{this, id, gen}};
+          if (streamed) {
+            std::lock_guard lk{streammtx};
+            uploads[id] = reader;
+          }
+          // The parts keep the received message alive instead of copying out of it.
+          reader->Push(0, Buffer{view.data(), view.size(), [msg](auto, size_t) {}}, !streamed);
+          entry->upload(reader, [id, gen, gate, this](std::exception_ptr ep, BufferView view) {
+            Release(gate);
+            Upload(id, true);
+            if (!ep) return SendResponse(id, view, gen);
             try {
               std::rethrow_exception(ep);
-            } catch (std::exception const &ex) {
-              auto exinfo = proto::CreateExceptionInfoDirect(buf, ex.what());
-              auto exobj  = proto::Service::Send::CreateException(buf, id, exinfo);
-              packet = proto::Service::Send::CreateSendPacket(buf, proto::Service::Send::Send_Exception, exobj.Union());
+            } catch (std::exception const &ex) { SendException(id, ex.what(), gen); } catch (...) {
+              SendException(id, "Unknown exception", gen);
             }
-          } else {
-            auto payload = buf.CreateVector(view.data(), view.size());
-            auto respobj = proto::Service::Send::CreateResponse(buf, id, payload);
-            packet = proto::Service::Send::CreateSendPacket(buf, proto::Service::Send::Send_Response, respobj.Union());
+          });
+        } else if (entry && entry->stream) {
+          auto chunked = (features & FeatureStreaming) != 0;
+          std::shared_ptr<StreamWriter> writer{new StreamWriter{this, id, gen, gate, chunked, streamWindow}};
+          if (chunked) {
+            std::lock_guard lk{streammtx};
+            streams[id] = writer;
           }
-          buf.Finish(packet);
-          ws.send(conhdr, buf.GetBufferPointer(), buf.GetSize(), opcode::BINARY);
-        });
+          try {
+            entry->stream({view.data(), view.size()}, writer);
+          } catch (std::exception const &ex) { writer->Fail(ex.what()); } catch (...) {
+            writer->Fail("Unknown exception");
+          }
+        } else if (inlined && entry->typed) {
+          flatbuffers::FlatBufferBuilder buf{256};
+          auto root = [&]() -> Expected<flatbuffers::uoffset_t> {
+            try {
+              return entry->typed(view, buf);
+            } catch (std::exception const &ex) { return Error{ex.what()}; } catch (...) {
+              return Error{"Unknown exception"};
+            }
+          }();
+          Release(gate);
+          if (!root) return SendException(id, root.error().message, gen);
+          Complete(id);
+          EncodeNestedResponse(buf, id, root.value());
+          Transmit(id, buf, gen);
+        } else if (inlined) {
+          auto result = [&]() -> Expected<Buffer> {
+            try {
+              return entry->direct ? entry->direct(view) : entry->sync(view);
+            } catch (std::exception const &ex) { return Error{ex.what()}; } catch (...) {
+              return Error{"Unknown exception"};
+            }
+          }();
+          Release(gate);
+          if (!result) return SendException(id, result.error().message, gen);
+          if (!cache) return SendResponse(id, result.value(), gen);
+          Complete(id);
+          flatbuffers::FlatBufferBuilder buf{256};
+          buf.ForceDefaults(true);
+          EncodeResponse(buf, id, result.value());
+          cache->Insert(hash, request, {(char const *) buf.GetBufferPointer(), buf.GetSize()});
+          Transmit(id, buf, gen);
+        } else {
+          auto &handler = entry && entry->async ? entry->async : defaultHandler;
+          auto shared = flights ? std::string{request} : std::string{};
+          handler(
+              {view.data(), view.size()},
+              [id, gen, gate, flights, shared{std::move(shared)}, this](std::exception_ptr ep, BufferView view) {
+                Release(gate);
+                auto waiters = flights ? flights->Finish(shared) : std::vector<Flights::Waiter>{{id, gen}};
+                std::string message = "Unknown exception";
+                if (ep) {
+                  try {
+                    std::rethrow_exception(ep);
+                  } catch (std::exception const &ex) { message = ex.what(); } catch (...) {
+                  }
+                }
+                if (waiters.size() == 1) {
+                  auto [id, gen] = waiters.front();
+                  return ep ? SendException(id, message, gen) : SendResponse(id, view, gen);
+                }
+                // Coalesced waiters share one encoding; only the id is rewritten between their packets.
+                flatbuffers::FlatBufferBuilder buf{256};
+                buf.ForceDefaults(true);
+                if (ep)
+                  EncodeException(buf, 0, message);
+                else
+                  EncodeResponse(buf, 0, view);
+                std::string packet{(char const *) buf.GetBufferPointer(), buf.GetSize()};
+                for (auto [id, gen] : waiters) {
+                  Complete(id);
+                  if (ep)
+                    PatchId<proto::Service::Send::Exception>(packet, id);
+                  else
+                    PatchId<proto::Service::Send::Response>(packet, id);
+                  Transmit(id, packet, gen);
+                }
+              });
+        }
       }
     }
   } catch (std::exception const &ex) {
@@ -69,61 +828,201 @@ void Service::OnMessage(websocketpp::connection_hdl hdl, websocketpp::config::as
   }
 }
 
-void Service::Connect(const std::string &endpoint, ServiceDesc desc) {
+void Service::Connect(const std::string &endpoint, ServiceDesc desc, std::chrono::milliseconds timeout) {
+  ConnectAsync(endpoint, std::move(desc), timeout).get();
+}
+
+std::future<void>
+Service::ConnectAsync(const std::string &endpoint, ServiceDesc desc, std::chrono::milliseconds timeout) {
+  auto promise = std::make_shared<std::promise<void>>();
+  auto future  = promise->get_future();
+  ConnectAsync(
+      endpoint, std::move(desc),
+      [promise](std::exception_ptr ep) {
+        if (ep)
+          promise->set_exception(ep);
+        else
+          promise->set_value();
+      },
+      timeout);
+  return future;
+}
+
+void Service::ConnectAsync(
+    const std::string &endpoint,
+    ServiceDesc desc,
+    std::function<void(std::exception_ptr)> done,
+    std::chrono::milliseconds timeout) {
   websocketpp::lib::error_code ec;
   ws.init_asio();
   ws.set_user_agent("ws-gw/0");
   ws.clear_access_channels(websocketpp::log::alevel::all);
   ws.clear_error_channels(websocketpp::log::elevel::all);
   ws.set_message_handler(std::bind(&Service::OnMessage, this, _1, _2));
-  ws.set_close_handler([this](auto) { ws.stop(); });
+  ws.set_pong_handler([this](auto, std::string payload) { OnPong(payload); });
+  ws.set_close_handler([this](websocketpp::connection_hdl hdl) {
+    if (!hdl.owner_before(conhdr) && !conhdr.owner_before(hdl)) Drop();
+  });
   ws.set_fail_handler([this](websocketpp::connection_hdl hdl) {
+    if (established && heartbeat.reconnect && !ep) return Reconnect();
     ep = std::make_exception_ptr(ConnectFailedError{});
     ws.stop();
   });
   ws.set_open_handler([this, desc{std::move(desc)}](websocketpp::connection_hdl co) {
-    conhdr = co;
-    flatbuffers::FlatBufferBuilder buf{64};
+    {
+      std::unique_lock lk{conmtx};
+      conhdr = co;
+    }
+    // The first handshake is bounded by ConnectAsync's timeout; reconnects give the gateway heartbeat.timeout.
+    if (established) {
+      connectTimer = ws.set_timer(heartbeat.timeout.count(), [this, co](auto const &ec) {
+        if (ec || flag != 1 || co.owner_before(conhdr) || conhdr.owner_before(co)) return;
+        Drop();
+      });
+    }
+    flatbuffers::FlatBufferBuilder buf{256};
+    announced.assign(hosted.size() + 1, {});
+    auto announce = [&](HandlerTable &table, std::vector<HandlerEntry *> &entries) {
+      std::vector<flatbuffers::Offset<flatbuffers::String>> names;
+      for (auto &[name, entry] : table) {
+        if (entry.Empty()) continue;
+        names.push_back(buf.CreateString(name));
+        entries.push_back(&entry);
+      }
+      return names;
+    };
+    auto names = announce(mapped, announced[0]);
+    std::vector<flatbuffers::Offset<proto::Service::HostedDesc>> descs;
+    for (size_t i = 0; i < hosted.size(); i++) {
+      auto &item  = hosted[i];
+      auto hnames = announce(item.mapped, announced[i + 1]);
+      descs.push_back(proto::Service::CreateHostedDescDirect(
+          buf, item.desc.name.c_str(), item.desc.identifier.c_str(), item.desc.version.c_str(), &hnames));
+    }
+    uint32_t requested =
+        FeatureSubscriberNotify | FeatureBroadcastBatch | FeatureMethodIds | FeatureStreaming | FeatureUploads;
+    if (!hosted.empty()) requested |= FeatureMultiplex;
     buf.Finish(proto::Service::CreateHandshakeDirect(
-        buf, "WS-GATEWAY", 0, desc.name.c_str(), desc.identifier.c_str(), desc.version.c_str()));
-    auto data = buf.GetBufferPointer();
-    auto size = buf.GetSize();
+        buf, "WS-GATEWAY", 0, desc.name.c_str(), desc.identifier.c_str(), desc.version.c_str(), requested, &names,
+        uploadWindow, hosted.empty() ? nullptr : &descs));
     try {
-      ws.send(co, data, size, opcode::BINARY);
+      Send(buf.GetBufferPointer(), buf.GetSize());
     } catch (std::exception const &ex) {
       if (!ep) ep = std::make_exception_ptr(ex);
       ws.stop();
     }
   });
   auto con = ws.get_connection(endpoint, ec);
-  if (ec) throw ParseFailed(ec);
-  ws.connect(con);
-
-  std::thread{[this] {
-    {
-      std::unique_lock lk{mtx};
-      cv.wait(lk, [this] { return flag.load() == 1; });
+  onconnect = std::move(done);
+  if (ec) {
+    // Nothing is queued, so the thread below stops at once and reports the failure like any other.
+    ep = std::make_exception_ptr(ParseFailed(ec));
+  } else {
+    this->endpoint = endpoint;
+    ws.connect(con);
+    if (timeout.count()) {
+      connectTimer = ws.set_timer(timeout.count(), [this](auto const &ec) {
+        if (ec || flag != 1) return;
+        ep = std::make_exception_ptr(ConnectTimeoutError{});
+        ws.stop();
+      });
     }
+  }
+  flag = 1;
 
+  std::thread{[this] {
     ws.run();
     if (onstop) onstop(ep);
     if (!ep) ep = std::make_exception_ptr(DisconnectedError{});
     flag = -1;
     cv.notify_all();
+    if (auto fn = std::exchange(onconnect, nullptr)) fn(ep);
   }}.detach();
+}
 
-  flag = 1;
-  cv.notify_all();
+// Runs on the io_service while connected: sends a ping once the previous one was answered and interval has passed
+// since it was sent, and drops the connection once a ping has gone unanswered for timeout.
+void Service::Heartbeat() {
+  if (flag != 2 || !heartbeat.interval.count()) return;
+  auto now = Tracer::clock::now();
+  if (awaitingPong && now - pinged >= heartbeat.timeout) {
+    if (!heartbeat.reconnect) ep = std::make_exception_ptr(HeartbeatTimeoutError{});
+    return Drop();
+  }
+  if (!awaitingPong && now - pinged >= heartbeat.interval) {
+    websocketpp::lib::error_code ec;
+    ws.ping(conhdr, std::to_string(++pingSeq), ec);
+    pinged       = now;
+    awaitingPong = true;
+  }
+  auto due = pinged + (awaitingPong ? std::min(heartbeat.interval, heartbeat.timeout) : heartbeat.interval);
+  if (due <= now) due = pinged + heartbeat.timeout;
+  heartbeatTimer =
+      ws.set_timer(std::chrono::ceil<std::chrono::milliseconds>(due - now).count(), [this](auto const &ec) {
+        if (!ec) Heartbeat();
+      });
+}
+
+// Smooths the round trip the way TCP does for its retransmission timer (RFC 6298).
+void Service::OnPong(std::string const &payload) {
+  if (!awaitingPong || payload != std::to_string(pingSeq)) return;
+  awaitingPong = false;
+  int64_t rtt  = std::chrono::duration_cast<std::chrono::microseconds>(Tracer::clock::now() - pinged).count();
+  auto smooth  = srtt.load(std::memory_order_relaxed);
+  auto var     = rttvar.load(std::memory_order_relaxed);
+  if (!smooth) {
+    smooth = rtt;
+    var    = rtt / 2;
+  } else {
+    var    = (3 * var + std::abs(smooth - rtt)) / 4;
+    smooth = (7 * smooth + rtt) / 8;
+  }
+  srtt.store(smooth, std::memory_order_relaxed);
+  rttvar.store(var, std::memory_order_relaxed);
+}
 
+// Gives up on the current connection. Unless reconnecting applies, the Service stops; otherwise requests paused or
+// streaming on the old connection are dropped, since the gateway has already failed them, and a new connection is
+// made. The old one is closed in the background and anything it still delivers is ignored.
+void Service::Drop() {
+  if (heartbeatTimer) heartbeatTimer->cancel();
+  if (!heartbeat.reconnect || !established || ep) return ws.stop();
+  websocketpp::lib::error_code ec;
+  ws.close(conhdr, close_status::going_away, "", ec);
   {
-    std::unique_lock lk{mtx};
-    cv.wait(lk, [this] { return flag.load() != 1; });
+    std::unique_lock lk{conmtx};
+    conhdr.reset();
+    generation++;
   }
-  if (ep) {
-    ws.close(con, close_status::abnormal_close, "");
-    flag = 0;
-    std::rethrow_exception(ep);
+  flag      = 1;
+  congested = false;
+  paused.clear();
+  std::vector<std::shared_ptr<StreamWriter>> writers;
+  std::map<uint32_t, std::shared_ptr<StreamReader>> readers;
+  {
+    std::lock_guard lk{streammtx};
+    for (auto &[id, writer] : streams)
+      if (auto locked = writer.lock()) writers.push_back(std::move(locked));
+    readers.swap(uploads);
   }
+  for (auto &writer : writers) writer->Cancel();
+  for (auto &[id, reader] : readers) reader->Abort(std::make_exception_ptr(DisconnectedError{}));
+  Reconnect();
+}
+
+void Service::Reconnect() {
+  auto delay = backoff.count() ? backoff : heartbeat.reconnectDelay;
+  backoff    = std::min(delay * 2, heartbeat.maxReconnectDelay);
+  ws.set_timer(delay.count(), [this](auto const &ec) {
+    if (ec) return;
+    websocketpp::lib::error_code cec;
+    auto con = ws.get_connection(endpoint, cec);
+    if (cec) {
+      ep = std::make_exception_ptr(ParseFailed(cec));
+      return ws.stop();
+    }
+    ws.connect(con);
+  });
 }
 
 void Service::Wait() {
@@ -132,20 +1031,335 @@ void Service::Wait() {
   if (ep) std::rethrow_exception(ep);
 }
 
-void Service::Broadcast(const std::string_view &key, BufferView data) {
-  if (flag != 2) return;
-  flatbuffers::FlatBufferBuilder buf{256};
-  auto skey    = buf.CreateString(key);
-  auto payload = buf.CreateVector(data.data(), data.size());
-  auto broad   = proto::Service::Send::CreateBroadcast(buf, skey, payload);
-  auto packet  = proto::Service::Send::CreateSendPacket(buf, proto::Service::Send::Send_Broadcast, broad.Union());
-  buf.Finish(packet);
+BroadcastStatus Service::Broadcast(const std::string_view &key, BufferView data) {
+  if (flag != 2) return BroadcastStatus::Offline;
+  return Broadcast(Key(key), data);
+}
+
+BroadcastStatus Service::Broadcast(KeyState &state, BufferView data) {
+  if (flag != 2 || (state.service && !(features & FeatureMultiplex))) return BroadcastStatus::Offline;
+  if (backpressure.failBroadcasts && congested) return BroadcastStatus::Backpressured;
+  if ((features & FeatureSubscriberNotify) && !state.subscribed) return BroadcastStatus::NoSubscribers;
+  if (state.interval.count()) return Conflate(state, data);
+  Publish(state, data);
+  return BroadcastStatus::Sent;
+}
+
+// Conflated keys still go through Conflate one by one; everything else is encoded into a single BroadcastBatch frame,
+// or into consecutive Broadcast frames from one builder when the gateway does not accept batches.
+BroadcastStatus Service::Broadcast(std::vector<std::pair<std::string_view, BufferView>> const &items) {
+  if (flag != 2) return BroadcastStatus::Offline;
+  if (backpressure.failBroadcasts && congested) return BroadcastStatus::Backpressured;
+  auto batched = (features & FeatureBroadcastBatch) != 0;
+  std::vector<KeyState *> states;
+  std::vector<flatbuffers::Offset<proto::Service::Send::Broadcast>> offsets;
+  flatbuffers::FlatBufferBuilder buf{1024};
+  try {
+    for (auto &[key, data] : items) {
+      auto &state = Key(key);
+      if ((features & FeatureSubscriberNotify) && !state.subscribed) continue;
+      if (state.interval.count()) {
+        Conflate(state, data);
+        continue;
+      }
+      auto broad = state.Encode(buf, data, Bind(state));
+      if (batched) {
+        offsets.push_back(broad);
+        states.push_back(&state);
+        continue;
+      }
+      buf.Finish(proto::Service::Send::CreateSendPacket(buf, proto::Service::Send::Send_Broadcast, broad.Union()));
+      Send(buf.GetBufferPointer(), buf.GetSize());
+      state.broadcasts.fetch_add(1, std::memory_order_relaxed);
+      buf.Clear();
+    }
+    if (offsets.empty()) return BroadcastStatus::Sent;
+    auto batch  = proto::Service::Send::CreateBroadcastBatch(buf, buf.CreateVector(offsets));
+    auto packet = proto::Service::Send::CreateSendPacket(buf, proto::Service::Send::Send_BroadcastBatch, batch.Union());
+    buf.Finish(packet);
+    Send(buf.GetBufferPointer(), buf.GetSize());
+    for (auto state : states) state->broadcasts.fetch_add(1, std::memory_order_relaxed);
+  } catch (std::exception const &ex) {
+    ep = std::make_exception_ptr(ex);
+    ws.close(Connection(), close_status::abnormal_close, "");
+  }
+  return BroadcastStatus::Sent;
+}
+
+BroadcastChannel Service::Channel(std::string_view key) { return {this, Key(key).shared_from_this()}; }
+
+HostedService Service::Host(ServiceDesc desc) {
+  hosted.push_back({std::move(desc), {}});
+  return {this, static_cast<uint32_t>(hosted.size())};
+}
+
+BroadcastStatus HostedService::Broadcast(std::string_view key, BufferView data) {
+  if (srv->flag != 2) return BroadcastStatus::Offline;
+  return srv->Broadcast(srv->Key(key, index), data);
+}
+
+BroadcastChannel HostedService::Channel(std::string_view key) {
+  return {srv, srv->Key(key, index).shared_from_this()};
+}
+
+BroadcastStatus BroadcastChannel::Publish(BufferView data) { return srv->Broadcast(*state, data); }
+
+bool BroadcastChannel::HasSubscribers() const {
+  return !(srv->features & FeatureSubscriberNotify) || state->subscribed;
+}
+
+std::string const &BroadcastChannel::Key() const { return state->key; }
+
+bool Service::HasSubscribers(std::string_view key) { return HasSubscribers(key, 0); }
+
+bool Service::HasSubscribers(std::string_view key, uint32_t service) {
+  if (!(features & FeatureSubscriberNotify)) return true;
+  std::shared_lock lk{keymtx};
+  auto it = keys.find(std::pair{service, key});
+  return it != keys.end() && it->second->subscribed;
+}
+
+void Service::SetConflation(std::string_view key, std::chrono::microseconds interval) {
+  auto &state = Key(key);
+  std::lock_guard lk{state.mtx};
+  state.interval = interval;
+}
+
+// Declares the key's id the first time it is broadcast on a connection; returns whether broadcasts use the id.
+bool Service::Bind(KeyState &state) {
+  if (!(features & FeatureMethodIds)) return false;
+  if (state.bound) return true;
+  std::lock_guard lk{state.mtx};
+  if (state.bound) return true;
+  flatbuffers::FlatBufferBuilder buf{64};
+  auto bind = proto::Service::Send::CreateBindKey(buf, state.PushKey(buf), state.id, state.service);
+  buf.Finish(proto::Service::Send::CreateSendPacket(buf, proto::Service::Send::Send_BindKey, bind.Union()));
+  Send(buf.GetBufferPointer(), buf.GetSize());
+  state.bound = true;
+  return true;
+}
+
+void Service::Publish(KeyState &state, BufferView data) {
+  if (flag != 2 || (state.service && !(features & FeatureMultiplex))) return;
   try {
-    ws.send(conhdr, buf.GetBufferPointer(), buf.GetSize(), opcode::BINARY);
+    flatbuffers::FlatBufferBuilder buf{256};
+    auto broad  = state.Encode(buf, data, Bind(state));
+    auto packet = proto::Service::Send::CreateSendPacket(buf, proto::Service::Send::Send_Broadcast, broad.Union());
+    buf.Finish(packet);
+    Send(buf.GetBufferPointer(), buf.GetSize());
+    state.broadcasts.fetch_add(1, std::memory_order_relaxed);
   } catch (std::exception const &ex) {
     ep = std::make_exception_ptr(ex);
-    ws.close(conhdr, close_status::abnormal_close, "");
+    ws.close(Connection(), close_status::abnormal_close, "");
+  }
+}
+
+// Sends right away when the last flush is older than the interval and nothing is queued on the socket; otherwise
+// the update replaces the pending value, which a timer flushes once the interval has passed. While congested with
+// dropConflated set, the timer leaves the value pending and Drain publishes it.
+BroadcastStatus Service::Conflate(KeyState &state, BufferView data) {
+  std::unique_lock lk{state.mtx};
+  auto now     = Tracer::clock::now();
+  auto elapsed = now - state.flushed;
+  if (!state.armed && !state.pending && elapsed >= state.interval && SendQueue() == 0) {
+    state.flushed = now;
+    lk.unlock();
+    Publish(state, data);
+    return BroadcastStatus::Sent;
+  }
+  state.pending = data;
+  if (state.armed) return BroadcastStatus::Conflated;
+  state.armed = true;
+  auto timer  = std::make_shared<websocketpp::lib::asio::steady_timer>(ws.get_io_service());
+  timer->expires_after(elapsed >= state.interval ? Tracer::clock::duration::zero() : state.interval - elapsed);
+  timer->async_wait([this, &state, timer](auto const &ec) {
+    if (!ec) Flush(state);
+  });
+  return BroadcastStatus::Conflated;
+}
+
+void Service::Flush(KeyState &state) {
+  std::optional<std::string> pending;
+  {
+    std::lock_guard lk{state.mtx};
+    state.armed = false;
+    if (backpressure.dropConflated && congested) return;
+    state.flushed = Tracer::clock::now();
+    pending.swap(state.pending);
+  }
+  if (pending) Publish(state, *pending);
+}
+
+void Service::SetBackpressure(BackpressureOptions options) { backpressure = std::move(options); }
+
+void Service::Congest() {
+  if (congested.exchange(true)) return;
+  if (backpressure.onHighWatermark) backpressure.onHighWatermark();
+  Post([this] {
+    SetReading(false);
+    Drain();
+  });
+}
+
+void Service::SetReading(bool on) {
+  if (!backpressure.pauseRequests) return;
+  websocketpp::lib::error_code ec;
+  auto con = ws.get_con_from_hdl(conhdr, ec);
+  if (!ec) on ? con->resume_reading() : con->pause_reading();
+}
+
+// Runs on the io_service until the buffered amount falls to the low watermark, then replays the requests that
+// were held, resumes reading and flushes the conflated keys that were held back.
+void Service::Drain() {
+  if (flag == 2 && SendQueue() > backpressure.lowWatermark) {
+    ws.set_timer(backpressure.pollInterval.count(), [this](auto const &ec) {
+      if (!ec) Drain();
+    });
+    return;
+  }
+  congested = false;
+  if (backpressure.onLowWatermark) backpressure.onLowWatermark();
+  while (!paused.empty() && !congested) {
+    auto msg = std::move(paused.front());
+    paused.pop_front();
+    OnMessage(conhdr, msg);
+  }
+  if (!congested) SetReading(true);
+  std::vector<KeyState *> held;
+  {
+    std::shared_lock lk{keymtx};
+    for (auto &[key, state] : keys) held.push_back(state.get());
   }
+  for (auto state : held) {
+    std::unique_lock lk{state->mtx};
+    if (state->armed || !state->pending) continue;
+    state->armed = true;
+    lk.unlock();
+    Flush(*state);
+  }
+}
+
+size_t Service::SendQueue() {
+  if (flag != 2) return 0;
+  websocketpp::lib::error_code ec;
+  auto con = ws.get_con_from_hdl(Connection(), ec);
+  return ec ? 0 : con->get_buffered_amount();
+}
+
+void Service::Post(std::function<void()> fn) {
+#ifdef WSGW_COROUTINE
+  ws.get_io_service().post([this, fn{std::move(fn)}] {
+    detail::FramePoolScope scope{pool};
+    fn();
+  });
+#else
+  ws.get_io_service().post(std::move(fn));
+#endif
+}
+
+#ifdef WSGW_COROUTINE
+FramePool::~FramePool() {
+  for (auto head : freelist) {
+    while (head) {
+      auto next = *static_cast<void **>(head);
+      ::operator delete(head);
+      head = next;
+    }
+  }
+}
+
+void *FramePool::Allocate(size_t size) {
+  auto bucket = (size - 1) / granularity;
+  if (bucket >= freelist.size()) return ::operator new(size);
+  {
+    std::lock_guard lk{mtx};
+    if (auto head = freelist[bucket]) {
+      freelist[bucket] = *static_cast<void **>(head);
+      return head;
+    }
+  }
+  return ::operator new((bucket + 1) * granularity);
+}
+
+void FramePool::Deallocate(void *ptr, size_t size) noexcept {
+  auto bucket = (size - 1) / granularity;
+  if (bucket >= freelist.size()) return ::operator delete(ptr);
+  std::lock_guard lk{mtx};
+  *static_cast<void **>(ptr) = freelist[bucket];
+  freelist[bucket]           = ptr;
+}
+
+namespace {
+struct Detached {
+  struct promise_type : detail::FramePromise {
+    Detached get_return_object() const noexcept { return {}; }
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+    void return_void() const noexcept {}
+    void unhandled_exception() const noexcept { std::terminate(); }
+  };
+};
+
+Detached Drive(Task<Buffer> task, std::function<void(std::exception_ptr, BufferView)> cb) {
+  std::exception_ptr ep;
+  Buffer result;
+  try {
+    result = co_await std::move(task);
+  } catch (...) { ep = std::current_exception(); }
+  cb(ep, ep ? BufferView{} : BufferView{result});
+}
+} // namespace
+
+// Registered as an async handler, so limits and coalescing apply as they do to Handlers.
+void Service::RegisterHandler(std::string const &name, CoHandler handler) {
+  Register(
+      name,
+      [this, handler{std::move(handler)}](Buffer buffer, auto cb) {
+        detail::FramePoolScope scope{pool};
+        Drive(handler(std::move(buffer)), std::move(cb));
+      },
+      {});
+}
+#endif
+
+ServiceStats Service::Stats() {
+  ServiceStats ret;
+  for (auto &slot : slots) {
+    ret.framesIn += slot.framesIn.load(std::memory_order_relaxed);
+    ret.framesOut += slot.framesOut.load(std::memory_order_relaxed);
+    ret.bytesIn += slot.bytesIn.load(std::memory_order_relaxed);
+    ret.bytesOut += slot.bytesOut.load(std::memory_order_relaxed);
+    ret.verifyFailures += slot.verifyFailures.load(std::memory_order_relaxed);
+    ret.inflight += slot.inflight.load(std::memory_order_relaxed);
+  }
+  ret.reconnects = reconnects.load(std::memory_order_relaxed);
+  ret.rtt        = std::chrono::microseconds{srtt.load(std::memory_order_relaxed)};
+  ret.rttJitter  = std::chrono::microseconds{rttvar.load(std::memory_order_relaxed)};
+  {
+    std::shared_lock lk{keymtx};
+    for (auto &[key, state] : keys) {
+      auto &[service, name] = key;
+      ret.broadcasts.emplace(
+          service ? hosted[service - 1].desc.name + "/" + name : name,
+          state->broadcasts.load(std::memory_order_relaxed));
+    }
+  }
+  ret.sendQueue = SendQueue();
+  return ret;
+}
+
+void Service::EnableStatsHandler(std::string const &name) {
+  RegisterHandler(name, Handler{[this](Buffer, auto cb) {
+    auto stats = Stats();
+    flatbuffers::FlatBufferBuilder buf{256};
+    std::vector<flatbuffers::Offset<proto::Stats::KeyCounter>> broadcasts;
+    for (auto &[key, count] : stats.broadcasts)
+      broadcasts.push_back(proto::Stats::CreateKeyCounterDirect(buf, key.c_str(), count));
+    buf.Finish(proto::Stats::CreateServiceStatsDirect(
+        buf, stats.framesIn, stats.framesOut, stats.bytesIn, stats.bytesOut, stats.verifyFailures, stats.inflight,
+        stats.sendQueue, stats.reconnects, &broadcasts, stats.rtt.count(), stats.rttJitter.count()));
+    cb(nullptr, buf);
+  }});
 }
 
 } // namespace WsGw
\ No newline at end of file
@@ -0,0 +1,134 @@
+// Generates typed service stubs and client proxies from the rpc_service blocks of a schema.
+//
+//   ws-gw-codegen [-I dir]... schema.fbs output.h
+//
+// The output includes the header flatc generates for the same schema (<name>_generated.h).
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <flatbuffers/idl.h>
+#include <flatbuffers/util.h>
+
+namespace {
+
+std::string Qualify(flatbuffers::Definition const &def) {
+  std::string result;
+  for (auto &component : def.defined_namespace->components) result += "::" + component;
+  return result + "::" + def.name;
+}
+
+void Generate(std::ostream &os, flatbuffers::ServiceDef const &service) {
+  auto &name = service.name;
+  os << "// Handler methods are looked up on Derived:\n";
+  for (auto call : service.calls.vec)
+    os << "//   flatbuffers::Offset<" << Qualify(*call->response) << "> " << call->name << "(" << Qualify(*call->request)
+       << " const *req, flatbuffers::FlatBufferBuilder &buf);\n";
+  os << "template <typename Derived> class " << name << "Service : public ::WsGw::Service {\n"
+     << "public:\n"
+     << "  static constexpr char const *name = \"" << name << "\";\n\n"
+     << "  " << name << "Service(::WsGw::Handler fallback = [](::WsGw::Buffer, auto cb) {\n"
+     << "    cb(std::make_exception_ptr(std::runtime_error{\"Unknown method\"}), {});\n"
+     << "  })\n"
+     << "      : ::WsGw::Service(std::move(fallback)) {\n";
+  for (auto call : service.calls.vec) {
+    auto req  = Qualify(*call->request);
+    auto resp = Qualify(*call->response);
+    os << "    RegisterHandler<" << req << ", " << resp << ">(\"" << call->name << "\", [this](" << req
+       << " const *req, flatbuffers::FlatBufferBuilder &buf) {\n"
+       << "      return static_cast<Derived *>(this)->" << call->name << "(req, buf);\n"
+       << "    });\n";
+  }
+  os << "  }\n"
+     << "};\n\n";
+
+  os << "// Caller is invoked as caller(service, method, payload, callback), and calls\n"
+     << "// callback(std::exception_ptr, WsGw::BufferView) with the response payload.\n"
+     << "template <typename Caller> class " << name << "Client {\n"
+     << "  Caller caller;\n\n"
+     << "public:\n"
+     << "  explicit " << name << "Client(Caller caller) : caller(std::move(caller)) {}\n";
+  for (auto call : service.calls.vec) {
+    auto resp = Qualify(*call->response);
+    os << "\n"
+       << "  // req holds a finished " << Qualify(*call->request) << "; callback gets the verified response, or\n"
+       << "  // nullptr with the error.\n"
+       << "  template <typename F> void " << call->name << "(::WsGw::BufferView const &req, F callback) {\n"
+       << "    caller(\"" << name << "\", \"" << call->name << "\", req,\n"
+       << "           [callback{std::move(callback)}](std::exception_ptr ep, ::WsGw::BufferView resp) mutable {\n"
+       << "             if (!ep) {\n"
+       << "               flatbuffers::Verifier verifier{resp.data(), resp.size()};\n"
+       << "               if (verifier.VerifyBuffer<" << resp << ">(nullptr))\n"
+       << "                 return callback(nullptr, flatbuffers::GetRoot<" << resp << ">(resp.data()));\n"
+       << "               ep = std::make_exception_ptr(std::runtime_error{\"Invalid response payload\"});\n"
+       << "             }\n"
+       << "             callback(ep, static_cast<" << resp << " const *>(nullptr));\n"
+       << "           });\n"
+       << "  }\n";
+  }
+  os << "};\n\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::vector<std::string> includes;
+  std::vector<std::string> args;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-I" && i + 1 < argc)
+      includes.push_back(argv[++i]);
+    else
+      args.push_back(arg);
+  }
+  if (args.size() != 2) {
+    std::cerr << "usage: " << argv[0] << " [-I dir]... schema.fbs output.h" << std::endl;
+    return 2;
+  }
+  auto &schema = args[0];
+  auto &output = args[1];
+
+  std::string source;
+  if (!flatbuffers::LoadFile(schema.c_str(), false, &source)) {
+    std::cerr << "cannot read " << schema << std::endl;
+    return 1;
+  }
+  includes.push_back(flatbuffers::StripFileName(schema));
+  std::vector<char const *> paths;
+  for (auto &dir : includes) paths.push_back(dir.c_str());
+  paths.push_back(nullptr);
+
+  flatbuffers::Parser parser;
+  if (!parser.Parse(source.c_str(), paths.data(), schema.c_str())) {
+    std::cerr << parser.error_ << std::endl;
+    return 1;
+  }
+
+  std::ostringstream os;
+  os << "// automatically generated by ws-gw-codegen, do not modify\n\n"
+     << "#pragma once\n\n"
+     << "#include <exception>\n"
+     << "#include <stdexcept>\n"
+     << "#include <utility>\n\n"
+     << "#include <ws-gw.h>\n\n"
+     << "#include \"" << flatbuffers::StripPath(flatbuffers::StripExtension(schema)) << "_generated.h\"\n\n";
+  for (auto service : parser.services_.vec) {
+    if (service->generated) continue;
+    auto &components = service->defined_namespace->components;
+    for (auto &component : components) os << "namespace " << component << " {\n";
+    if (!components.empty()) os << "\n";
+    Generate(os, *service);
+    for (auto it = components.rbegin(); it != components.rend(); ++it) os << "} // namespace " << *it << "\n";
+    if (!components.empty()) os << "\n";
+  }
+
+  std::ofstream file{output, std::ios::binary};
+  file << os.str();
+  if (!file) {
+    std::cerr << "cannot write " << output << std::endl;
+    return 1;
+  }
+}